@@ -0,0 +1,488 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 16 Oct 2026 4:35:12pm
+    Author:  thoma
+
+    Headless DSP micro-benchmarks for EQProcessor. Results are written as JSON
+    so runs from different releases can be diffed by a script.
+
+        EQBenchmark [--quick] [--output=results.json]
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <numeric>
+#include "../../Source/BiquadCascade.h"
+#include "../../Source/CoefficientDesigner.h"
+#include "../../Source/EQParameters.h"
+#include "../../Source/EQProcessor.h"
+#include "../../Source/MultiStreamEQ.h"
+
+namespace
+{
+    struct Sweep
+    {
+        juce::Array<int> blockSizes;
+        juce::Array<double> sampleRates;
+        juce::Array<int> channelCounts;
+    };
+
+    Sweep getSweep(bool quick)
+    {
+        if (quick)
+            return { { 32, 128, 512 }, { 48000.0 }, { 2, 16 } };
+
+        return { { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 },
+                 { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 },
+                 { 1, 2, 6, 8, 16 } };
+    }
+
+    double ticksToNs(juce::int64 ticks)
+    {
+        return 1.0e9 * static_cast<double>(ticks) / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    }
+
+    // Best-of-N timing in ns for one call of fn, which is run callsPerRound times per round.
+    // The fastest round is the least disturbed by the scheduler, which is what we want to compare.
+    template <typename Fn>
+    double timeNsPerCall(Fn&& fn, int callsPerRound, int numRounds = 5)
+    {
+        fn(); // warm up caches and branch predictors
+
+        double best = std::numeric_limits<double>::max();
+
+        for (int round = 0; round < numRounds; ++round)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+
+            for (int i = 0; i < callsPerRound; ++i)
+                fn();
+
+            best = juce::jmin(best, ticksToNs(juce::Time::getHighResolutionTicks() - start) / callsPerRound);
+        }
+
+        return best;
+    }
+
+    // About 50 ms of audio per round
+    int getBlocksPerRound(double sampleRate, int blockSize)
+    {
+        return juce::jmax(4, static_cast<int>(0.05 * sampleRate / blockSize));
+    }
+
+    void fillWithNoise(juce::AudioBuffer<float>& buffer)
+    {
+        juce::Random random(1234);
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(ch, i, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    void copyInput(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& buffer)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            buffer.copyFrom(ch, 0, input, ch, 0, buffer.getNumSamples());
+    }
+
+    int numNonFiniteOutputs = 0;
+
+    // Like timeNsPerCall() for in-place processing of buffer. Every call starts from a fresh copy of input,
+    // as feeding the EQ its own output would run the boosts off to inf and NaN within a round (and NaN
+    // would then be timed instead of the filters). The copy alone is timed the same way and taken off.
+    template <typename Fn>
+    double timeProcessNsPerCall(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& buffer, Fn&& process, int callsPerRound)
+    {
+        const auto copyNs = timeNsPerCall([&]() { copyInput(input, buffer); }, callsPerRound);
+        const auto totalNs = timeNsPerCall([&]() { copyInput(input, buffer); process(); }, callsPerRound);
+
+        // Not through findMinAndMax, whose SIMD min and max may pass over NaN
+        const auto* const* channels = buffer.getArrayOfReadPointers();
+        const bool isFinite = std::all_of(channels, channels + buffer.getNumChannels(), [&buffer](const float* channel)
+        {
+            return std::all_of(channel, channel + buffer.getNumSamples(), [](float x) { return std::isfinite(x); });
+        });
+
+        jassert(isFinite);
+        if (!isFinite)
+            ++numNonFiniteOutputs;
+
+        return juce::jmax(0.0, totalNs - copyNs);
+    }
+
+    juce::var makeResult(const juce::String& target, double sampleRate, int blockSize,
+                         int numChannels, int numBands, double nsPerBlock)
+    {
+        const double nsPerFrame = nsPerBlock / blockSize;
+
+        auto* result = new juce::DynamicObject();
+        result->setProperty("target", target);
+        result->setProperty("sampleRate", sampleRate);
+        result->setProperty("blockSize", blockSize);
+        result->setProperty("channels", numChannels);
+        result->setProperty("bands", numBands);
+        result->setProperty("nsPerSample", nsPerFrame / numChannels);
+        result->setProperty("nsPerFrame", nsPerFrame);
+        result->setProperty("realtimeFactor", (1.0e9 / sampleRate) / nsPerFrame);
+        return juce::var(result);
+    }
+
+    juce::var makeCallResult(const juce::String& target, double nsPerCall)
+    {
+        auto* result = new juce::DynamicObject();
+        result->setProperty("target", target);
+        result->setProperty("nsPerCall", nsPerCall);
+        return juce::var(result);
+    }
+
+    // High-pass, peaks at +3 dB and (with all six) the low-pass: every band is active
+    void setActiveBands(EQParameters& parameters, int numBands)
+    {
+        parameters.setNumBands(numBands);
+
+        for (int band = 1; band < juce::jmin(numBands, Constants::defaultNumBands - 1); ++band)
+            parameters.setBand(band, Constants::defaultFrequencies[band], 3.0f, 1.0f);
+    }
+
+    // Whole processor: snapshot check plus the cascade, for a typical 3-band correction and the full default set
+    void benchmarkProcess(const Sweep& sweep, juce::Array<juce::var>& results)
+    {
+        for (auto sampleRate : sweep.sampleRates)
+        {
+            for (int numBands : { 3, Constants::defaultNumBands })
+            {
+                for (auto numChannels : sweep.channelCounts)
+                {
+                    for (auto blockSize : sweep.blockSizes)
+                    {
+                        EQProcessor eq;
+                        eq.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) });
+                        EQParameters parameters(eq);
+                        setActiveBands(parameters, numBands);
+
+                        juce::AudioBuffer<float> input(numChannels, blockSize), buffer(numChannels, blockSize);
+                        fillWithNoise(input);
+
+                        const auto ns = timeProcessNsPerCall(input, buffer, [&]() { eq.process(buffer); }, getBlocksPerRound(sampleRate, blockSize));
+                        results.add(makeResult("EQProcessor::process", sampleRate, blockSize, numChannels, numBands, ns));
+                    }
+                }
+            }
+
+            std::cerr << "process @ " << sampleRate << " Hz done" << std::endl;
+        }
+    }
+
+    // Whole processor once the input has gone silent and the filter tails have died away: only the silence scan is left
+    void benchmarkSilence(const Sweep& sweep, juce::Array<juce::var>& results)
+    {
+        const double sampleRate = 48000.0;
+
+        for (auto numChannels : sweep.channelCounts)
+        {
+            for (auto blockSize : sweep.blockSizes)
+            {
+                EQProcessor eq;
+                eq.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) });
+                EQParameters parameters(eq);
+                setActiveBands(parameters, Constants::defaultNumBands);
+
+                juce::AudioBuffer<float> input(numChannels, blockSize), buffer(numChannels, blockSize);
+                fillWithNoise(buffer);
+                eq.process(buffer);
+
+                // Two seconds of silence, far longer than the slowest tail
+                input.clear();
+                for (int i = 0; i < static_cast<int>(2.0 * sampleRate / blockSize) + 1; ++i)
+                {
+                    copyInput(input, buffer);
+                    eq.process(buffer);
+                }
+
+                const auto ns = timeProcessNsPerCall(input, buffer, [&]() { eq.process(buffer); }, getBlocksPerRound(sampleRate, blockSize));
+                results.add(makeResult("EQProcessor::process (silent input)", sampleRate, blockSize, numChannels, Constants::defaultNumBands, ns));
+            }
+        }
+
+        std::cerr << "silence done" << std::endl;
+    }
+
+    // Whole processor at every oversampling factor, so the cost of each can be weighed against its accuracy
+    void benchmarkOversampling(const Sweep& sweep, juce::Array<juce::var>& results)
+    {
+        const double sampleRate = 48000.0;
+
+        for (int order = 0; order <= EQProcessor::maxOversamplingOrder; ++order)
+        {
+            for (auto numChannels : sweep.channelCounts)
+            {
+                for (auto blockSize : sweep.blockSizes)
+                {
+                    EQProcessor eq;
+                    eq.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) });
+                    eq.setOversamplingOrder(order);
+                    EQParameters parameters(eq);
+                    setActiveBands(parameters, Constants::defaultNumBands);
+
+                    juce::AudioBuffer<float> input(numChannels, blockSize), buffer(numChannels, blockSize);
+                    fillWithNoise(input);
+
+                    const auto ns = timeProcessNsPerCall(input, buffer, [&]() { eq.process(buffer); }, getBlocksPerRound(sampleRate, blockSize));
+                    auto result = makeResult("EQProcessor::process (oversampled)", sampleRate, blockSize, numChannels, Constants::defaultNumBands, ns);
+                    result.getDynamicObject()->setProperty("oversampling", 1 << order);
+                    result.getDynamicObject()->setProperty("latencySamples", eq.getLatencyInSamples());
+                    results.add(result);
+                }
+            }
+        }
+
+        std::cerr << "oversampling done" << std::endl;
+    }
+
+    // Linear-phase FIR through the partitioned convolution, mostly to see small blocks stay affordable
+    void benchmarkLinearPhase(const Sweep& sweep, juce::Array<juce::var>& results)
+    {
+        const double sampleRate = 48000.0;
+
+        for (auto numChannels : sweep.channelCounts)
+        {
+            for (auto blockSize : sweep.blockSizes)
+            {
+                EQProcessor eq;
+                eq.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) });
+                eq.setLinearPhase(true);
+                EQParameters parameters(eq);
+                setActiveBands(parameters, Constants::defaultNumBands);
+
+                juce::AudioBuffer<float> input(numChannels, blockSize), buffer(numChannels, blockSize);
+                fillWithNoise(input);
+
+                // The kernel is designed and partitioned in the background, then crossfaded in over a few blocks
+                copyInput(input, buffer);
+                eq.process(buffer);
+                juce::Thread::sleep(300);
+                for (int i = 0; i < getBlocksPerRound(sampleRate, blockSize) * 4; ++i)
+                {
+                    copyInput(input, buffer);
+                    eq.process(buffer);
+                }
+
+                const auto ns = timeProcessNsPerCall(input, buffer, [&]() { eq.process(buffer); }, getBlocksPerRound(sampleRate, blockSize));
+                auto result = makeResult("EQProcessor::process (linear phase)", sampleRate, blockSize, numChannels, Constants::defaultNumBands, ns);
+                result.getDynamicObject()->setProperty("latencySamples", eq.getLatencyInSamples());
+                results.add(result);
+            }
+        }
+
+        std::cerr << "linear phase done" << std::endl;
+    }
+
+    // Whole processor in the middle of a preset morph, which redesigns every band at control rate
+    void benchmarkMorph(const Sweep& sweep, juce::Array<juce::var>& results)
+    {
+        const double sampleRate = 48000.0;
+
+        for (auto numChannels : sweep.channelCounts)
+        {
+            for (auto blockSize : sweep.blockSizes)
+            {
+                EQProcessor eq;
+                eq.prepare({ sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) });
+
+                // B keeps the flat default curve, A gets the six active bands
+                EQParameters parameters(eq);
+                setActiveBands(parameters, Constants::defaultNumBands);
+
+                juce::AudioBuffer<float> input(numChannels, blockSize), buffer(numChannels, blockSize);
+                fillWithNoise(input);
+                copyInput(input, buffer);
+                eq.process(buffer);
+
+                // Long enough that every timed block is still gliding
+                parameters.switchToPreset(EQParameters::B, 3600.0);
+
+                const auto ns = timeProcessNsPerCall(input, buffer, [&]() { eq.process(buffer); }, getBlocksPerRound(sampleRate, blockSize));
+                results.add(makeResult("EQProcessor::process (morphing)", sampleRate, blockSize, numChannels, Constants::defaultNumBands, ns));
+            }
+        }
+
+        std::cerr << "morph done" << std::endl;
+    }
+
+    // One mono EQ per console channel, on the calling thread alone and fanned out over the worker pool
+    void benchmarkMultiStream(const Sweep& sweep, juce::Array<juce::var>& results)
+    {
+        const double sampleRate = 48000.0;
+        MultiStreamEQ engine;
+
+        for (int numStreams : { 8, 32, 64, 128 })
+        {
+            for (auto blockSize : sweep.blockSizes)
+            {
+                engine.prepare(sampleRate, blockSize, numStreams);
+
+                // Every stream gets its own curve
+                for (int s = 0; s < numStreams; ++s)
+                {
+                    auto curve = EQProcessor::getDefaultCurve();
+                    for (int band = 1; band < Constants::defaultNumBands - 1; ++band)
+                        curve.bands[band].gainDb = static_cast<float>((s + band) % 7) - 3.0f;
+                    engine.getStream(s).setCurve(curve);
+                }
+
+                juce::AudioBuffer<float> input(numStreams, blockSize), buffer(numStreams, blockSize);
+                fillWithNoise(input);
+
+                for (bool fanOut : { false, true })
+                {
+                    engine.setFanOutThreshold(fanOut ? 1 : std::numeric_limits<int>::max());
+                    const auto ns = timeProcessNsPerCall(input, buffer, [&]() { engine.process(buffer); }, getBlocksPerRound(sampleRate, blockSize));
+                    auto result = makeResult(fanOut ? "MultiStreamEQ::process (pool)" : "MultiStreamEQ::process (calling thread)",
+                                             sampleRate, blockSize, numStreams, Constants::defaultNumBands, ns);
+                    result.getDynamicObject()->setProperty("workers", fanOut ? engine.getNumWorkerThreads() : 0);
+                    results.add(result);
+                }
+            }
+        }
+
+        std::cerr << "multi-stream done (" << engine.getNumDeadlineMisses() << " deadline misses)" << std::endl;
+    }
+
+    // Kernel alone, over the range of section counts
+    void benchmarkCascade(const Sweep& sweep, juce::Array<juce::var>& results)
+    {
+        const double sampleRate = 48000.0;
+
+        for (int numSections : { 1, 2, 3, 4, 6, 8, 12, 16, 24, 32 })
+        {
+            for (auto numChannels : sweep.channelCounts)
+            {
+                for (auto blockSize : sweep.blockSizes)
+                {
+                    std::vector<int> channels((size_t)numChannels);
+                    std::iota(channels.begin(), channels.end(), 0);
+
+                    BiquadCascade cascade;
+                    cascade.prepare(channels, blockSize);
+                    cascade.setNumSections(numSections);
+
+                    // Stable band-pass, poles at radius 0.9
+                    for (int k = 0; k < numSections; ++k)
+                        cascade.setCoefficients(k, { 0.2f, 0.0f, -0.2f, -1.6f, 0.81f });
+
+                    juce::AudioBuffer<float> input(numChannels, blockSize), buffer(numChannels, blockSize);
+                    fillWithNoise(input);
+                    juce::dsp::AudioBlock<float> block(buffer);
+
+                    const auto ns = timeProcessNsPerCall(input, buffer, [&]() { cascade.process(block); }, getBlocksPerRound(sampleRate, blockSize));
+                    results.add(makeResult("BiquadCascade::process", sampleRate, blockSize, numChannels, numSections, ns));
+                }
+            }
+        }
+
+        std::cerr << "cascade done" << std::endl;
+    }
+
+    // Message thread costs
+    void benchmarkControl(juce::Array<juce::var>& results)
+    {
+        EQProcessor eq;
+        eq.prepare({ 48000.0, 512, 2 });
+        EQParameters parameters(eq);
+
+        int call = 0;
+        const auto updateNs = timeNsPerCall([&]()
+        {
+            const int band = call % Constants::defaultNumBands;
+            parameters.setBand(band, 200.0f + static_cast<float>(call % 1000), 1.0f, 1.0f);
+            ++call;
+        }, 10000);
+
+        results.add(makeCallResult("EQParameters::setBand", updateNs));
+
+        // All six bands at once, the cost of a control-rate redesign on the audio thread
+        const CoefficientDesigner::FilterType types[Constants::defaultNumBands] = {
+            CoefficientDesigner::HighPass, CoefficientDesigner::Peak, CoefficientDesigner::Peak,
+            CoefficientDesigner::Peak, CoefficientDesigner::Peak, CoefficientDesigner::LowPass };
+        float freqs[Constants::defaultNumBands], gains[Constants::defaultNumBands], Qs[Constants::defaultNumBands];
+        for (int i = 0; i < Constants::defaultNumBands; ++i)
+        {
+            freqs[i] = Constants::defaultFrequencies[i];
+            gains[i] = 3.0f;
+            Qs[i] = Constants::defaultQs[i];
+        }
+
+        std::array<BiquadCoefficients, Constants::defaultNumBands> designed;
+        const auto designNs = timeNsPerCall([&]()
+        {
+            freqs[1] = 100.0f + static_cast<float>(call++ % 64); // defeat hoisting
+            CoefficientDesigner::design(Constants::defaultNumBands, types, freqs, gains, Qs, 48000.0, designed.data());
+        }, 100000);
+
+        results.add(makeCallResult("CoefficientDesigner::design", designNs));
+
+        const int numPoints = 512;
+        int point = 0;
+        volatile float sink = 0.0f;
+        const auto magnitudeNs = timeNsPerCall([&]()
+        {
+            const double freq = Constants::minFreq * std::pow(Constants::maxFreq / Constants::minFreq, (double)point / (numPoints - 1));
+            sink = eq.getMagnitudeForFrequency(freq, 48000.0);
+            point = (point + 1) % numPoints;
+        }, numPoints * 20);
+
+        results.add(makeCallResult("EQProcessor::getMagnitudeForFrequency", magnitudeNs));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+    const bool quick = args.containsOption("--quick");
+
+    juce::Array<juce::var> results;
+
+    benchmarkProcess(getSweep(quick), results);
+    benchmarkSilence(getSweep(quick), results);
+    benchmarkOversampling(getSweep(quick), results);
+    benchmarkLinearPhase(getSweep(quick), results);
+    benchmarkMorph(getSweep(quick), results);
+    benchmarkMultiStream(getSweep(quick), results);
+    benchmarkCascade(getSweep(quick), results);
+    benchmarkControl(results);
+
+    auto* report = new juce::DynamicObject();
+    report->setProperty("juceVersion", juce::SystemStats::getJUCEVersion());
+    report->setProperty("cpu", juce::SystemStats::getCpuModel());
+    report->setProperty("numCpus", juce::SystemStats::getNumCpus());
+    report->setProperty("simdLanes", BiquadCascade::lanes);
+    report->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+    report->setProperty("results", results);
+
+    const auto json = juce::JSON::toString(juce::var(report));
+
+    // Timings of runaway (inf or NaN) output say nothing about the filters
+    if (numNonFiniteOutputs > 0)
+    {
+        std::cerr << numNonFiniteOutputs << " benchmarks produced non-finite output" << std::endl;
+        return 1;
+    }
+
+    if (args.containsOption("--output"))
+    {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output"));
+        if (!file.replaceWithText(json))
+        {
+            std::cerr << "Could not write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    return 0;
+}
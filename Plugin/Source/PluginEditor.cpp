@@ -0,0 +1,28 @@
+/*
+  ==============================================================================
+
+    PluginEditor.cpp
+    Created: 17 Oct 2026 4:02:18pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "PluginEditor.h"
+
+EQPluginEditor::EQPluginEditor(EQPluginProcessor& processor)
+    : juce::AudioProcessorEditor(processor),
+      eqUI(processor.getEQ(), processor.getParameters(), processor.getAnalyzer())
+{
+    eqUI.setPerformanceMonitor(processor.getPerformance());
+    addAndMakeVisible(eqUI);
+
+    setResizable(true, true);
+    setResizeLimits(640, 480, 2400, 1600);
+    setSize(1000, 700);
+}
+
+void EQPluginEditor::resized()
+{
+    eqUI.setBounds(getLocalBounds());
+}
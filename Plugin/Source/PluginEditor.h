@@ -0,0 +1,30 @@
+/*
+  ==============================================================================
+
+    PluginEditor.h
+    Created: 17 Oct 2026 4:02:18pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "../../Source/EQUI.h"
+
+// The app's EQ view inside the host window
+class EQPluginEditor : public juce::AudioProcessorEditor
+{
+    public:
+        explicit EQPluginEditor(EQPluginProcessor& processor);
+        ~EQPluginEditor() override = default;
+
+        void resized() override;
+
+    private:
+        EQUI eqUI;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EQPluginEditor)
+};
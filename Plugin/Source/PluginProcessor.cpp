@@ -0,0 +1,282 @@
+/*
+  ==============================================================================
+
+    PluginProcessor.cpp
+    Created: 17 Oct 2026 4:02:18pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+
+namespace
+{
+    juce::String getBandParameterID(int bandIndex, const char* name)
+    {
+        return "band" + juce::String(bandIndex + 1) + "_" + name;
+    }
+}
+
+EQPluginProcessor::EQPluginProcessor()
+    : juce::AudioProcessor(BusesProperties()
+                               .withInput("Input", juce::AudioChannelSet::stereo(), true)
+                               .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
+      state(*this, nullptr, "EQ", createParameterLayout())
+{
+    for (int i = 0; i < Constants::maxBands; ++i)
+    {
+        auto& values = bandValues[i];
+        values.freq = state.getRawParameterValue(getBandParameterID(i, "freq"));
+        values.gain = state.getRawParameterValue(getBandParameterID(i, "gain"));
+        values.q = state.getRawParameterValue(getBandParameterID(i, "q"));
+        values.type = state.getRawParameterValue(getBandParameterID(i, "type"));
+        values.enabled = state.getRawParameterValue(getBandParameterID(i, "enabled"));
+    }
+
+    numBandsValue = state.getRawParameterValue("numBands");
+    oversamplingValue = state.getRawParameterValue("oversampling");
+    linearPhaseValue = state.getRawParameterValue("linearPhase");
+
+    // The curve only ever comes from the host parameters, the editor edits those
+    eq.setCurveFromAutomation(true);
+
+    automatedCurve = eq.getCurve();
+    readHostCurve(automatedCurve);
+    syncedCurve = automatedCurve;
+    parameters.setCurve(syncedCurve);
+
+    startTimerHz(30);
+}
+
+EQPluginProcessor::~EQPluginProcessor()
+{
+    stopTimer();
+}
+
+void EQPluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
+    spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
+
+    eq.prepare(spec, getChannelLayoutOfBus(false, 0));
+    analyzer.prepare(sampleRate);
+    performance.prepare(sampleRate);
+
+    setLatencySamples(juce::roundToInt(eq.getLatencyInSamples()));
+}
+
+bool EQPluginProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
+{
+    // Any layout EQProcessor can filter, as long as it goes straight through
+    const auto& output = layouts.getMainOutputChannelSet();
+    return !output.isDisabled() && output == layouts.getMainInputChannelSet();
+}
+
+void EQPluginProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    EQ_TRACE_SCOPE("processBlock");
+
+    juce::ScopedNoDenormals noDenormals;
+
+    PerformanceMonitor::ScopedCallback timing(performance, buffer.getNumSamples());
+
+    for (auto ch = getTotalNumInputChannels(); ch < getTotalNumOutputChannels(); ++ch)
+        buffer.clear(ch, 0, buffer.getNumSamples());
+
+    // Automation is block-accurate: JUCE's wrappers pass on one value per parameter and block, so the
+    // host's curve takes over at the block start (a host that splits its cycles gets finer steps that way).
+    // Blocks without automation cost nothing extra.
+    const bool changed = readHostCurve(automatedCurve);
+    const EQProcessor::AutomationPoint point{ 0, &automatedCurve };
+
+    juce::dsp::AudioBlock<float> block(buffer);
+
+    // Only copies into the analyzer's FIFOs, the FFTs run on its own thread
+    analyzer.pushBlock(SpectrumAnalyzer::PreEQ, block);
+    {
+        PerformanceMonitor::ScopedEQ eqTiming(timing);
+        eq.process(block, &point, changed ? 1 : 0);
+    }
+    analyzer.pushBlock(SpectrumAnalyzer::PostEQ, block);
+}
+
+juce::AudioProcessorEditor* EQPluginProcessor::createEditor()
+{
+    return new EQPluginEditor(*this);
+}
+
+void EQPluginProcessor::getStateInformation(juce::MemoryBlock& destData)
+{
+    if (auto xml = state.copyState().createXml())
+        copyXmlToBinary(*xml, destData);
+}
+
+void EQPluginProcessor::setStateInformation(const void* data, int sizeInBytes)
+{
+    // The audio thread and the editor pick the new values up like any other host change
+    if (auto xml = getXmlFromBinary(data, sizeInBytes))
+        if (xml->hasTagName(state.state.getType()))
+            state.replaceState(juce::ValueTree::fromXml(*xml));
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout EQPluginProcessor::createParameterLayout()
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    juce::StringArray oversamplingFactors;
+    for (int order = 0; order <= EQProcessor::maxOversamplingOrder; ++order)
+        oversamplingFactors.add(juce::String(1 << order) + "x");
+
+    layout.add(std::make_unique<juce::AudioParameterInt>(juce::ParameterID{ "numBands", 1 }, "Bands",
+                                                         1, Constants::maxBands, Constants::defaultNumBands));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{ "oversampling", 1 }, "Oversampling",
+                                                            oversamplingFactors, 0));
+    layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{ "linearPhase", 1 }, "Linear phase", false));
+
+    juce::NormalisableRange<float> freqRange(static_cast<float>(Constants::minFreq), static_cast<float>(Constants::maxFreq));
+    freqRange.setSkewForCentre(1000.0f);
+    juce::NormalisableRange<float> gainRange(Constants::minDb, Constants::maxDb);
+    juce::NormalisableRange<float> qRange(Constants::minQ, Constants::maxQ);
+    qRange.setSkewForCentre(1.0f);
+
+    // Every band exists for the host, numBands decides how many are used
+    for (int i = 0; i < Constants::maxBands; ++i)
+    {
+        const auto defaults = EQProcessor::getDefaultBand(i);
+        const auto name = "Band " + juce::String(i + 1);
+
+        auto group = std::make_unique<juce::AudioProcessorParameterGroup>("band" + juce::String(i + 1), name, " | ");
+        group->addChild(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ getBandParameterID(i, "freq"), 1 },
+            name + " Frequency", freqRange, defaults.freq, juce::AudioParameterFloatAttributes().withLabel("Hz")));
+        group->addChild(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ getBandParameterID(i, "gain"), 1 },
+            name + " Gain", gainRange, defaults.gainDb, juce::AudioParameterFloatAttributes().withLabel("dB")));
+        group->addChild(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ getBandParameterID(i, "q"), 1 },
+            name + " Q", qRange, defaults.Q));
+        group->addChild(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{ getBandParameterID(i, "type"), 1 },
+            name + " Type", juce::StringArray{ "High-pass", "Peak", "Low-pass" }, defaults.type));
+        group->addChild(std::make_unique<juce::AudioParameterBool>(juce::ParameterID{ getBandParameterID(i, "enabled"), 1 },
+            name + " Enabled", defaults.enabled));
+
+        layout.add(std::move(group));
+    }
+
+    return layout;
+}
+
+void EQPluginProcessor::timerCallback()
+{
+    // Whichever side differs from the last agreed state was edited since. The editor wins a tie.
+    auto hostCurve = syncedCurve;
+    readHostCurve(hostCurve);
+
+    const auto& editorCurve = parameters.getCurve();
+    auto newEditorCurve = editorCurve;
+    bool hostEdited = false;
+
+    if (editorCurve.numBands != syncedCurve.numBands)
+        setHostValue("numBands", static_cast<float>(editorCurve.numBands));
+    else if (hostCurve.numBands != syncedCurve.numBands)
+    {
+        newEditorCurve.numBands = hostCurve.numBands;
+        hostEdited = true;
+    }
+
+    for (int i = 0; i < Constants::maxBands; ++i)
+    {
+        const auto& edited = editorCurve.bands[i];
+        const auto& synced = syncedCurve.bands[i];
+
+        if (!EQProcessor::isSameBand(edited, synced))
+        {
+            setHostValue(getBandParameterID(i, "freq"), edited.freq);
+            setHostValue(getBandParameterID(i, "gain"), edited.gainDb);
+            setHostValue(getBandParameterID(i, "q"), edited.Q);
+            setHostValue(getBandParameterID(i, "type"), static_cast<float>(edited.type));
+            setHostValue(getBandParameterID(i, "enabled"), edited.enabled ? 1.0f : 0.0f);
+        }
+        else if (!EQProcessor::isSameBand(hostCurve.bands[i], synced))
+        {
+            newEditorCurve.bands[i] = hostCurve.bands[i];
+            hostEdited = true;
+        }
+    }
+
+    // The editor follows through EQParameters' version, like any other outside edit
+    if (hostEdited)
+        parameters.setCurve(newEditorCurve);
+
+    syncedCurve = parameters.getCurve();
+
+    const int hostOrder = juce::roundToInt(oversamplingValue->load());
+    if (eq.getOversamplingOrder() != syncedOversamplingOrder)
+        setHostValue("oversampling", static_cast<float>(eq.getOversamplingOrder()));
+    else if (hostOrder != syncedOversamplingOrder)
+        eq.setOversamplingOrder(hostOrder);
+    syncedOversamplingOrder = eq.getOversamplingOrder();
+
+    const bool hostLinearPhase = linearPhaseValue->load() >= 0.5f;
+    if (eq.isLinearPhase() != syncedLinearPhase)
+        setHostValue("linearPhase", eq.isLinearPhase() ? 1.0f : 0.0f);
+    else if (hostLinearPhase != syncedLinearPhase)
+        eq.setLinearPhase(hostLinearPhase);
+    syncedLinearPhase = eq.isLinearPhase();
+
+    // Follows the audio thread once it has switched modes
+    const int latency = juce::roundToInt(eq.getLatencyInSamples());
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+bool EQPluginProcessor::readHostCurve(EQProcessor::Curve& curve) const
+{
+    bool changed = false;
+    auto update = [&changed](auto& field, auto value)
+    {
+        if (field != value)
+        {
+            field = value;
+            changed = true;
+        }
+    };
+
+    update(curve.numBands, juce::roundToInt(numBandsValue->load(std::memory_order_relaxed)));
+
+    for (int i = 0; i < Constants::maxBands; ++i)
+    {
+        const auto& values = bandValues[i];
+        auto& band = curve.bands[i];
+
+        update(band.freq, values.freq->load(std::memory_order_relaxed));
+        update(band.gainDb, values.gain->load(std::memory_order_relaxed));
+        update(band.Q, values.q->load(std::memory_order_relaxed));
+        update(band.type, static_cast<EQProcessor::FilterType>(juce::roundToInt(values.type->load(std::memory_order_relaxed))));
+        update(band.enabled, values.enabled->load(std::memory_order_relaxed) >= 0.5f);
+    }
+
+    return changed;
+}
+
+void EQPluginProcessor::setHostValue(const juce::String& parameterID, float value)
+{
+    auto* parameter = state.getParameter(parameterID);
+    if (parameter == nullptr)
+        return;
+
+    const float normalised = parameter->convertTo0to1(value);
+    if (parameter->getValue() == normalised)
+        return;
+
+    parameter->beginChangeGesture();
+    parameter->setValueNotifyingHost(normalised);
+    parameter->endChangeGesture();
+}
+
+// Creates new instances of the plugin
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new EQPluginProcessor();
+}
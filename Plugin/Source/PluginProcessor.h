@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    PluginProcessor.h
+    Created: 17 Oct 2026 4:02:18pm
+    Author:  thoma
+
+    The EQ as a VST3 / LV2 / standalone plugin. The host owns the parameters:
+    the audio thread reads them once per block and hands any change to
+    EQProcessor as an automation point at the block start (block-accurate
+    automation, as JUCE's wrappers give one value per block), and the editor (the same EQUI as the
+    app) is kept in step with them from the message thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/EQParameters.h"
+#include "../../Source/EQProcessor.h"
+#include "../../Source/PerformanceMonitor.h"
+#include "../../Source/SpectrumAnalyzer.h"
+
+class EQPluginProcessor : public juce::AudioProcessor,
+    private juce::Timer
+{
+    public:
+        EQPluginProcessor();
+        ~EQPluginProcessor() override;
+
+        void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+        void releaseResources() override {}
+        bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
+
+        void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) override;
+        using juce::AudioProcessor::processBlock;
+
+        juce::AudioProcessorEditor* createEditor() override;
+        bool hasEditor() const override { return true; }
+
+        const juce::String getName() const override { return JucePlugin_Name; }
+        bool acceptsMidi() const override { return false; }
+        bool producesMidi() const override { return false; }
+        bool isMidiEffect() const override { return false; }
+        double getTailLengthSeconds() const override { return 0.0; }
+
+        int getNumPrograms() override { return 1; }
+        int getCurrentProgram() override { return 0; }
+        void setCurrentProgram(int) override {}
+        const juce::String getProgramName(int) override { return {}; }
+        void changeProgramName(int, const juce::String&) override {}
+
+        void getStateInformation(juce::MemoryBlock& destData) override;
+        void setStateInformation(const void* data, int sizeInBytes) override;
+
+        EQProcessor& getEQ() { return eq; }
+        EQParameters& getParameters() { return parameters; }
+        SpectrumAnalyzer& getAnalyzer() { return analyzer; }
+        PerformanceMonitor& getPerformance() { return performance; }
+
+    private:
+        static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
+
+        // Message thread: carries edits between the host parameters and the editor's EQParameters
+        void timerCallback() override;
+
+        // Any thread. Reads the host's curve into curve, returns true if it differs.
+        bool readHostCurve(EQProcessor::Curve& curve) const;
+        void setHostValue(const juce::String& parameterID, float value);
+
+        EQProcessor eq;
+        EQParameters parameters{ eq };
+        SpectrumAnalyzer analyzer;
+        PerformanceMonitor performance;
+
+        juce::AudioProcessorValueTreeState state;
+
+        // Raw values of the host parameters, read lock-free on the audio thread
+        struct BandValues
+        {
+            std::atomic<float>* freq = nullptr;
+            std::atomic<float>* gain = nullptr;
+            std::atomic<float>* q = nullptr;
+            std::atomic<float>* type = nullptr;
+            std::atomic<float>* enabled = nullptr;
+        };
+        std::array<BandValues, Constants::maxBands> bandValues;
+        std::atomic<float>* numBandsValue = nullptr;
+        std::atomic<float>* oversamplingValue = nullptr;
+        std::atomic<float>* linearPhaseValue = nullptr;
+
+        // Audio thread: the curve last handed to eq
+        EQProcessor::Curve automatedCurve;
+
+        // Message thread: what the host and the editor last agreed on
+        EQProcessor::Curve syncedCurve;
+        int syncedOversamplingOrder = 0;
+        bool syncedLinearPhase = false;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EQPluginProcessor)
+};
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.cpp
+    Created: 16 Oct 2026 1:58:33pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "BatchRenderer.h"
+
+juce::Result BatchRenderer::parseCommandLine(const juce::StringArray& args, Options& options)
+{
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+    for (int i = 0; i < args.size(); ++i)
+    {
+        const auto& arg = args[i];
+        const bool hasValue = i + 1 < args.size();
+
+        if (arg == "--render")
+            continue;
+
+        if (arg == "--settings" && hasValue)
+            options.settingsFile = cwd.getChildFile(args[++i]);
+        else if (arg == "--output" && hasValue)
+            options.outputDirectory = cwd.getChildFile(args[++i]);
+        else if (arg == "--threads" && hasValue)
+            options.numThreads = juce::jmax(1, args[++i].getIntValue());
+        else if (arg == "--block-size" && hasValue)
+            options.blockSize = juce::jlimit(16, 65536, args[++i].getIntValue());
+        else if (arg.startsWith("--"))
+            return juce::Result::fail("Unknown or incomplete option: " + arg);
+        else
+        {
+            const auto path = cwd.getChildFile(arg);
+
+            if (path.isDirectory())
+                options.inputFiles.addArray(path.findChildFiles(juce::File::findFiles, true, "*.wav;*.flac;*.aif;*.aiff"));
+            else if (path.existsAsFile())
+                options.inputFiles.add(path);
+            else
+                return juce::Result::fail("No such file or folder: " + arg);
+        }
+    }
+
+    if (options.settingsFile == juce::File())
+        return juce::Result::fail("Missing --settings <file>");
+
+    if (options.outputDirectory == juce::File())
+        return juce::Result::fail("Missing --output <folder>");
+
+    if (options.inputFiles.isEmpty())
+        return juce::Result::fail("No input files");
+
+    // Outputs keep their file names, so two inputs with the same name would overwrite each other
+    juce::StringArray names;
+    for (const auto& file : options.inputFiles)
+    {
+        if (names.contains(file.getFileName(), true))
+            return juce::Result::fail("Duplicate input file name: " + file.getFileName());
+
+        names.add(file.getFileName());
+    }
+
+    return juce::Result::ok();
+}
+
+int BatchRenderer::run(const Options& options)
+{
+    auto bands = EQSettings::getDefaults();
+    auto loadResult = EQSettings::load(options.settingsFile, bands);
+    if (loadResult.failed())
+    {
+        std::cerr << loadResult.getErrorMessage() << std::endl;
+        return 1;
+    }
+
+    if (!options.outputDirectory.createDirectory())
+    {
+        std::cerr << "Could not create " << options.outputDirectory.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Rendering " << options.inputFiles.size() << " files on "
+              << options.numThreads << " threads" << std::endl;
+
+    StreamingRenderer::Options renderOptions;
+    renderOptions.blockSize = options.blockSize;
+
+    juce::CriticalSection reportLock;
+    double totalAudioSeconds = 0.0;
+    int numFailed = 0;
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    {
+        // One file per job, so each worker owns its EQProcessor, reader and writer
+        juce::ThreadPool pool(options.numThreads);
+
+        for (const auto& input : options.inputFiles)
+        {
+            pool.addJob([&, input]()
+            {
+                const auto output = options.outputDirectory.getChildFile(input.getFileName());
+                const auto fileResult = StreamingRenderer::render(input, output, bands, renderOptions);
+
+                const juce::ScopedLock sl(reportLock);
+
+                if (fileResult.result.failed())
+                {
+                    ++numFailed;
+                    std::cerr << input.getFileName() << ": " << fileResult.result.getErrorMessage() << std::endl;
+                    return;
+                }
+
+                totalAudioSeconds += fileResult.audioSeconds;
+                std::cout << input.getFileName() << ": "
+                          << juce::String(fileResult.audioSeconds / juce::jmax(1.0e-6, fileResult.wallSeconds), 1)
+                          << "x realtime" << (fileResult.memoryMapped ? " (mapped)" : "") << std::endl;
+            });
+        }
+
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(20);
+    }
+
+    const auto wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+    std::cout << "Done: " << (options.inputFiles.size() - numFailed) << " rendered, " << numFailed << " failed, "
+              << juce::String(totalAudioSeconds, 1) << " s of audio in " << juce::String(wallSeconds, 1) << " s ("
+              << juce::String(totalAudioSeconds / juce::jmax(1.0e-6, wallSeconds), 1) << "x realtime)" << std::endl;
+
+    return numFailed == 0 ? 0 : 1;
+}
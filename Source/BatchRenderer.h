@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.h
+    Created: 16 Oct 2026 1:58:33pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "EQSettings.h"
+#include "StreamingRenderer.h"
+
+// Headless mode: runs the same EQ curve over many audio files, one file per
+// worker thread, as fast as the disks and cores allow. Each file goes through
+// a StreamingRenderer, so even multi-hour files render in constant memory.
+//
+//  MyProject --render --settings curve.json --output <dir> [--threads N] [--block-size N] <files or folders>...
+class BatchRenderer
+{
+    public:
+        struct Options
+        {
+            juce::File settingsFile;
+            juce::File outputDirectory;
+            juce::Array<juce::File> inputFiles;
+            int numThreads = juce::SystemStats::getNumCpus();
+            int blockSize = 512;
+        };
+
+        static bool isRenderCommand(const juce::StringArray& args) { return args.contains("--render"); }
+        static juce::Result parseCommandLine(const juce::StringArray& args, Options& options);
+
+        // Returns the process exit code
+        static int run(const Options& options);
+};
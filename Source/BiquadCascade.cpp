@@ -0,0 +1,260 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.cpp
+    Created: 16 Oct 2026 11:02:18am
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "BiquadCascade.h"
+
+void BiquadCascade::prepare(const std::vector<int>& channelIndices, int maximumBlockSize)
+{
+    numGroups = ((int)channelIndices.size() + lanes - 1) / lanes;
+
+    channels = channelIndices;
+    channels.resize((size_t)(numGroups * lanes), -1);
+
+    state1.resize((size_t)(numGroups * maxSections));
+    state2.resize((size_t)(numGroups * maxSections));
+    groupIdle.assign((size_t)numGroups, false);
+
+    interleaved.resize((size_t)juce::jmax(1, maximumBlockSize));
+
+    // Unused lanes stay at zero so they never produce denormals or NaNs
+    std::fill(interleaved.begin(), interleaved.end(), Vec::expand(0.0f));
+
+    for (int k = 0; k < maxSections; ++k)
+        setCoefficients(k, {});
+
+    setNumSections(maxSections);
+    reset();
+}
+
+void BiquadCascade::reset()
+{
+    std::fill(state1.begin(), state1.end(), Vec::expand(0.0f));
+    std::fill(state2.begin(), state2.end(), Vec::expand(0.0f));
+    std::fill(groupIdle.begin(), groupIdle.end(), false);
+}
+
+void BiquadCascade::setCoefficients(int section, const BiquadCoefficients& coeffs)
+{
+    jassert(section >= 0 && section < maxSections);
+
+    auto& c = coefficients[(size_t)section];
+    c.b0 = Vec::expand(coeffs.b0);
+    c.b1 = Vec::expand(coeffs.b1);
+    c.b2 = Vec::expand(coeffs.b2);
+    c.a1 = Vec::expand(coeffs.a1);
+    c.a2 = Vec::expand(coeffs.a2);
+
+    for (int k = 0; k < numSections; ++k)
+        if (activeSections[(size_t)k] == section)
+            activeCoefficients[(size_t)k] = c;
+}
+
+void BiquadCascade::setActiveSections(const int* sections, int count)
+{
+    jassert(count >= 0 && count <= maxSections);
+    count = juce::jlimit(0, maxSections, count);
+
+    std::array<bool, maxSections> nowActive{};
+
+    for (int k = 0; k < count; ++k)
+    {
+        const int slot = sections[k];
+        jassert(slot >= 0 && slot < maxSections);
+
+        // Joining the cascade: start from a clean state
+        if (!isActive[(size_t)slot])
+        {
+            for (int group = 0; group < numGroups; ++group)
+            {
+                state1[(size_t)(group * maxSections + slot)] = Vec::expand(0.0f);
+                state2[(size_t)(group * maxSections + slot)] = Vec::expand(0.0f);
+            }
+        }
+
+        nowActive[(size_t)slot] = true;
+        activeSections[(size_t)k] = slot;
+        activeCoefficients[(size_t)k] = coefficients[(size_t)slot];
+    }
+
+    isActive = nowActive;
+    numSections = count;
+}
+
+void BiquadCascade::setNumSections(int newNumSections)
+{
+    jassert(newNumSections >= 0 && newNumSections <= maxSections);
+
+    std::array<int, maxSections> slots;
+    for (int k = 0; k < maxSections; ++k)
+        slots[(size_t)k] = k;
+
+    setActiveSections(slots.data(), juce::jlimit(0, maxSections, newNumSections));
+}
+
+void BiquadCascade::process(const juce::dsp::AudioBlock<float>& block)
+{
+    static constexpr auto kernels = makeKernels(std::make_index_sequence<maxSections + 1>());
+
+    const int blockChannels = (int)block.getNumChannels();
+    const int totalSamples = (int)block.getNumSamples();
+    const int chunkSize = (int)interleaved.size();
+
+    if (numSections == 0 || numGroups == 0 || chunkSize == 0)
+        return;
+
+    const auto kernel = kernels[(size_t)numSections];
+    auto* raw = reinterpret_cast<float*>(interleaved.data());
+
+    for (int group = 0; group < numGroups; ++group)
+    {
+        const bool silentInput = isGroupSilent(block, group);
+        if (silentInput && groupIdle[(size_t)group])
+            continue;
+
+        groupIdle[(size_t)group] = false;
+
+        const int* groupChannels = channels.data() + group * lanes;
+
+        // Gather the running slots' state so the kernel sees contiguous sections
+        Vec s1[maxSections], s2[maxSections];
+        for (int k = 0; k < numSections; ++k)
+        {
+            s1[k] = state1[(size_t)(group * maxSections + activeSections[(size_t)k])];
+            s2[k] = state2[(size_t)(group * maxSections + activeSections[(size_t)k])];
+        }
+
+        for (int start = 0; start < totalSamples; start += chunkSize)
+        {
+            const int numSamples = juce::jmin(chunkSize, totalSamples - start);
+
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                const int ch = groupChannels[lane];
+
+                // Padding lanes get silence rather than whatever the previous group left behind
+                if (ch < 0 || ch >= blockChannels)
+                {
+                    for (int i = 0; i < numSamples; ++i)
+                        raw[i * lanes + lane] = 0.0f;
+
+                    continue;
+                }
+
+                const auto* src = block.getChannelPointer((size_t)ch) + start;
+                for (int i = 0; i < numSamples; ++i)
+                    raw[i * lanes + lane] = src[i];
+            }
+
+            kernel(raw, numSamples, activeCoefficients.data(), s1, s2);
+
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                const int ch = groupChannels[lane];
+                if (ch < 0 || ch >= blockChannels)
+                    continue;
+
+                auto* dst = block.getChannelPointer((size_t)ch) + start;
+                for (int i = 0; i < numSamples; ++i)
+                    dst[i] = raw[i * lanes + lane];
+            }
+        }
+
+        // Rung out: rest from a clean state until signal returns
+        if (silentInput && hasDecayed(s1, s2))
+        {
+            std::fill(s1, s1 + numSections, Vec::expand(0.0f));
+            std::fill(s2, s2 + numSections, Vec::expand(0.0f));
+            groupIdle[(size_t)group] = true;
+        }
+
+        for (int k = 0; k < numSections; ++k)
+        {
+            state1[(size_t)(group * maxSections + activeSections[(size_t)k])] = s1[k];
+            state2[(size_t)(group * maxSections + activeSections[(size_t)k])] = s2[k];
+        }
+    }
+}
+
+bool BiquadCascade::isGroupSilent(const juce::dsp::AudioBlock<float>& block, int group) const
+{
+    const int blockChannels = (int)block.getNumChannels();
+    const int numSamples = (int)block.getNumSamples();
+
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+        const int ch = channels[(size_t)(group * lanes + lane)];
+        if (ch < 0 || ch >= blockChannels)
+            continue;
+
+        // Written so that NaN (and inf) counts as signal: a runaway channel never goes idle
+        const auto range = juce::FloatVectorOperations::findMinAndMax(block.getChannelPointer((size_t)ch), numSamples);
+        if (!(std::abs(range.getStart()) <= silenceThreshold) || !(std::abs(range.getEnd()) <= silenceThreshold))
+            return false;
+    }
+
+    return true;
+}
+
+bool BiquadCascade::hasDecayed(const Vec* s1, const Vec* s2) const
+{
+    // Each state on its own, as a SIMD max may drop a NaN operand. A NaN state has not decayed.
+    for (int k = 0; k < numSections; ++k)
+    {
+        const auto magnitude1 = Vec::abs(s1[k]);
+        const auto magnitude2 = Vec::abs(s2[k]);
+        for (size_t lane = 0; lane < (size_t)lanes; ++lane)
+            if (!(magnitude1.get(lane) <= silenceThreshold) || !(magnitude2.get(lane) <= silenceThreshold))
+                return false;
+    }
+
+    return true;
+}
+
+template <int NumSections>
+void BiquadCascade::processSections(float* interleaved, int numSamples,
+                                    const SectionCoefficients* coeffs, Vec* s1, Vec* s2)
+{
+    if constexpr (NumSections > 0)
+    {
+        // State in locals for the whole block: in registers for a few sections, partly on the stack beyond that
+        Vec z1[NumSections], z2[NumSections];
+        for (int k = 0; k < NumSections; ++k)
+        {
+            z1[k] = s1[k];
+            z2[k] = s2[k];
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto x = Vec::fromRawArray(interleaved + i * lanes);
+
+            for (int k = 0; k < NumSections; ++k)
+            {
+                const auto& c = coeffs[k];
+                const auto y = c.b0 * x + z1[k];
+                z1[k] = c.b1 * x - c.a1 * y + z2[k];
+                z2[k] = c.b2 * x - c.a2 * y;
+                x = y;
+            }
+
+            x.copyToRawArray(interleaved + i * lanes);
+        }
+
+        for (int k = 0; k < NumSections; ++k)
+        {
+            s1[k] = z1[k];
+            s2[k] = z2[k];
+        }
+    }
+    else
+    {
+        juce::ignoreUnused(interleaved, numSamples, coeffs, s1, s2);
+    }
+}
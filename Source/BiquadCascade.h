@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    BiquadCascade.h
+    Created: 16 Oct 2026 11:02:18am
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Constants.h"
+
+// Biquad normalised so that a0 == 1
+struct BiquadCoefficients
+{
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+};
+
+// Series of biquad sections (transposed direct form II) run in a single pass.
+// Channels are interleaved into the lanes of a SIMD register, so every sample
+// goes through all sections in one pass, instead of walking the block once per
+// section and once per channel. The filter state is copied into locals of a
+// kernel compiled for the section count: for a few sections it stays in
+// registers, larger counts spill part of it to the stack. Channel counts
+// above one register are split into lane groups (4 channels per group on SSE/NEON).
+//
+// Sections live in fixed slots (one per EQ band) and only the slots listed in
+// setActiveSections() are run, so bypassed or unity-gain bands cost nothing.
+//
+// A lane group whose input is silent for a whole block, and whose state has
+// decayed below the same threshold, goes idle: its state is zeroed and later
+// silent blocks pass through untouched. The first block with signal runs the
+// cascade again from that clean state, so idle channels cost one scan per block.
+class BiquadCascade
+{
+    public:
+        using Vec = juce::dsp::SIMDRegister<float>;
+
+        static constexpr int maxSections = Constants::maxBands;
+        static constexpr int lanes = (int)Vec::SIMDNumElements;
+
+        // Input samples and filter state below this (-120 dB) count as silence
+        static constexpr float silenceThreshold = 1.0e-6f;
+
+        BiquadCascade() = default;
+
+        // Not real-time safe (allocates state and the interleaving buffer).
+        // channelIndices lists the block channels to filter, any others are left untouched.
+        void prepare(const std::vector<int>& channelIndices, int maximumBlockSize);
+        void reset();
+
+        // Real-time safe
+        void setCoefficients(int section, const BiquadCoefficients& coeffs);
+
+        // Real-time safe. Runs the listed slots, in order. A slot that was not running
+        // restarts from silence, which is exact for a section that was at unity gain.
+        void setActiveSections(const int* sections, int count);
+        void setNumSections(int newNumSections); // slots 0 .. newNumSections - 1
+        void process(const juce::dsp::AudioBlock<float>& block);
+
+    private:
+        // Coefficients broadcast to every lane
+        struct SectionCoefficients
+        {
+            Vec b0, b1, b2, a1, a2;
+        };
+
+        using Kernel = void (*)(float* interleaved, int numSamples,
+                                const SectionCoefficients* coeffs, Vec* s1, Vec* s2);
+
+        template <int NumSections>
+        static void processSections(float* interleaved, int numSamples,
+                                    const SectionCoefficients* coeffs, Vec* s1, Vec* s2);
+
+        bool isGroupSilent(const juce::dsp::AudioBlock<float>& block, int group) const;
+        bool hasDecayed(const Vec* s1, const Vec* s2) const;
+
+        template <size_t... NumSections>
+        static constexpr std::array<Kernel, sizeof...(NumSections)> makeKernels(std::index_sequence<NumSections...>)
+        {
+            return { { &processSections<(int)NumSections>... } };
+        }
+
+        std::array<SectionCoefficients, maxSections> coefficients;
+
+        // Structure of arrays: [group * maxSections + section], one lane per channel
+        std::vector<Vec> state1, state2;
+
+        // One Vec per sample, lanes hold the channels of the group being processed
+        std::vector<Vec> interleaved;
+
+        // Block channel for each lane, padded to whole groups with -1
+        std::vector<int> channels;
+
+        int numGroups = 0;
+
+        // Groups resting between silent blocks, see the class comment
+        std::vector<bool> groupIdle;
+
+        // Slots to run, in order, and their coefficients packed for the kernel
+        std::array<int, maxSections> activeSections{};
+        std::array<SectionCoefficients, maxSections> activeCoefficients;
+        std::array<bool, maxSections> isActive{};
+        int numSections = 0;
+};
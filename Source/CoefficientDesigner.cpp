@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    CoefficientDesigner.cpp
+    Created: 17 Oct 2026 8:15:52pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "CoefficientDesigner.h"
+
+namespace
+{
+    // Bands are designed in fixed-size batches so the working set lives on the stack
+    constexpr int batchSize = 8;
+
+    // Taylor series on [0, pi/2], accurate to about 6e-8 at the top of the range
+    inline double sinHalfPi(double x) noexcept
+    {
+        const double x2 = x * x;
+        return x * (1.0 + x2 * (-1.0 / 6.0 + x2 * (1.0 / 120.0 + x2 * (-1.0 / 5040.0
+                 + x2 * (1.0 / 362880.0 + x2 * (-1.0 / 39916800.0))))));
+    }
+
+    inline double cosHalfPi(double x) noexcept
+    {
+        const double x2 = x * x;
+        return 1.0 + x2 * (-0.5 + x2 * (1.0 / 24.0 + x2 * (-1.0 / 720.0 + x2 * (1.0 / 40320.0
+                 + x2 * (-1.0 / 3628800.0 + x2 * (1.0 / 479001600.0))))));
+    }
+
+    // 2^y as 2^round(y) (built in the exponent bits) times 2^u, u in [-0.5, 0.5]
+    inline double exp2Fast(double y) noexcept
+    {
+        y = juce::jlimit(-100.0, 100.0, y);
+        const double whole = std::floor(y + 0.5);
+        const double u = (y - whole) * 0.69314718055994531;
+
+        const double fraction = 1.0 + u * (1.0 + u * (0.5 + u * (1.0 / 6.0 + u * (1.0 / 24.0
+                              + u * (1.0 / 120.0 + u * (1.0 / 720.0))))));
+
+        const auto bits = static_cast<uint64_t>(static_cast<int64_t>(whole) + 1023) << 52;
+        double scale;
+        std::memcpy(&scale, &bits, sizeof(scale));
+        return fraction * scale;
+    }
+
+    // The arithmetic is done in double: near-unit-circle poles make the float
+    // coefficients sensitive, and rounding only once at the end halves the curve error
+    void designBatch(int numBands, const CoefficientDesigner::FilterType* types, const float* freqs,
+                     const float* gainsDb, const float* Qs, double sampleRate, BiquadCoefficients* out) noexcept
+    {
+        using namespace CoefficientDesigner;
+
+        const double maxFreq = sampleRate * 0.49;
+        const double piOverRate = juce::MathConstants<double>::pi / sampleRate;
+
+        // dB to the peak's amplitude A = 10^(dB / 40)
+        constexpr double dBToLog2A = 3.3219280948873623 / 40.0;
+
+        double b0[batchSize], b1[batchSize], b2[batchSize], a1[batchSize], a2[batchSize];
+
+        for (int i = 0; i < numBands; ++i)
+        {
+            // Branch-free selection of the band shape
+            const double isPeak = types[i] == Peak ? 1.0 : 0.0;
+            const double isLow = types[i] == LowPass ? 1.0 : 0.0;
+            const double isHigh = types[i] == HighPass ? 1.0 : 0.0;
+
+            // Half angle x = w / 2; 1 - cos w = 2 sin^2 x avoids the cancellation at low frequencies
+            const double x = juce::jlimit(2.0, maxFreq, (double)freqs[i]) * piOverRate;
+            const double s = sinHalfPi(x);
+            const double c = cosHalfPi(x);
+            const double sinW = 2.0 * s * c;
+            const double cosW = c * c - s * s;
+
+            const double A = exp2Fast(isPeak * gainsDb[i] * dBToLog2A); // 1 for the pass filters
+            const double alpha = sinW / (2.0 * juce::jmax(0.01, (double)Qs[i]));
+
+            // Peak: 1 +/- alpha A, -2 cos w. Low-pass: sin^2 x (1, 2, 1). High-pass: cos^2 x (1, -2, 1).
+            const double s2 = s * s, c2 = c * c;
+            const double a0Inv = 1.0 / (1.0 + alpha / A);
+
+            b0[i] = (isPeak * (1.0 + alpha * A) + isLow * s2 + isHigh * c2) * a0Inv;
+            b1[i] = (isPeak * (-2.0 * cosW) + isLow * 2.0 * s2 - isHigh * 2.0 * c2) * a0Inv;
+            b2[i] = (isPeak * (1.0 - alpha * A) + isLow * s2 + isHigh * c2) * a0Inv;
+            a1[i] = -2.0 * cosW * a0Inv;
+            a2[i] = (1.0 - alpha / A) * a0Inv;
+        }
+
+        for (int i = 0; i < numBands; ++i)
+            out[i] = { (float)b0[i], (float)b1[i], (float)b2[i], (float)a1[i], (float)a2[i] };
+    }
+}
+
+void CoefficientDesigner::design(int numBands, const FilterType* types, const float* freqs, const float* gainsDb,
+                                 const float* Qs, double sampleRate, BiquadCoefficients* out) noexcept
+{
+    for (int start = 0; start < numBands; start += batchSize)
+    {
+        const int count = juce::jmin(batchSize, numBands - start);
+        designBatch(count, types + start, freqs + start, gainsDb + start, Qs + start,
+                    sampleRate, out + start);
+    }
+}
@@ -15,11 +15,12 @@ namespace Constants
 {
     // ============ EQ ================ //
 
-    // Number of bands.
-    constexpr int numBands = 6;
+    // Number of bands: the default layout (high-pass, four peaks, low-pass), and the most that can be configured.
+    constexpr int defaultNumBands = 6;
+    constexpr int maxBands = 32;
 
     // Colors of bands
-    inline const juce::Colour bandColours[numBands] = {
+    inline const juce::Colour bandColours[defaultNumBands] = {
         juce::Colour::fromRGB(139, 0, 1255),
         juce::Colour::fromRGB(0, 0, 255),
         juce::Colour::fromRGB(0, 255, 0),
@@ -28,10 +29,19 @@ namespace Constants
         juce::Colour::fromRGB(255, 0, 0)
     };
 
-    // Default parameters for each band (index-based)
-    constexpr float defaultFrequencies[numBands] = { 33.0f, 100.0f, 350.0f, 1350.0f, 5000.0f, 16000.0f };
+    // Bands past the default layout step around the colour wheel
+    inline juce::Colour getBandColour(int bandIndex)
+    {
+        if (bandIndex < defaultNumBands)
+            return bandColours[bandIndex];
+
+        return juce::Colour::fromHSV(std::fmod(bandIndex * 0.618034f, 1.0f), 0.8f, 1.0f, 1.0f);
+    }
+
+    // Default parameters for each band of the default layout (index-based)
+    constexpr float defaultFrequencies[defaultNumBands] = { 33.0f, 100.0f, 350.0f, 1350.0f, 5000.0f, 16000.0f };
     constexpr float defaultGain = 0;
-    constexpr float defaultQs[numBands] = { 0.707f, 1.0f, 1.0f,   1.0f,   1.0f,    0.707f };
+    constexpr float defaultQs[defaultNumBands] = { 0.707f, 1.0f, 1.0f,   1.0f,   1.0f,    0.707f };
 
     // Frequency labels for graph (EQ curve and FFT)
     constexpr float frequencyGraphLabels[10] = {
@@ -53,4 +63,10 @@ namespace Constants
     // Min and Max bandwidth values
     constexpr float minQ = 0.1f;
     constexpr float maxQ = 5.0f;
+
+    // ============ Analyzer ================ //
+
+    // dBFS range of the spectrum behind the EQ curve
+    constexpr float analyzerMinDb = -90.0f;
+    constexpr float analyzerMaxDb = 0.0f;
 }
\ No newline at end of file
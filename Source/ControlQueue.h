@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    ControlQueue.h
+    Created: 17 Oct 2026 7:40:12pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "Constants.h"
+
+// Wait-free multi-producer / single-consumer mailbox of band edits from remote
+// control. Every band and parameter has one slot that holds its latest value,
+// so the queue is bounded by construction and a burst of edits to one fader
+// coalesces into a single pending value. The consumer drains once per block.
+class ControlQueue
+{
+    public:
+        enum Parameter
+        {
+            Frequency = 0,
+            Gain,
+            Q,
+            numParameters
+        };
+
+        static_assert(Constants::maxBands <= 32, "One pending bit per band");
+
+        // ============ Producer side, any thread ============ //
+
+        void push(int bandIndex, Parameter parameter, float value) noexcept
+        {
+            if (bandIndex < 0 || bandIndex >= Constants::maxBands)
+                return;
+
+            values[parameter][bandIndex].store(value, std::memory_order_relaxed);
+            pending[parameter].fetch_or(1u << bandIndex, std::memory_order_release);
+        }
+
+        // ============ Consumer side ============ //
+
+        // A few relaxed loads when nothing is pending
+        bool hasPending() const noexcept
+        {
+            for (const auto& mask : pending)
+                if (mask.load(std::memory_order_relaxed) != 0)
+                    return true;
+
+            return false;
+        }
+
+        // Calls apply(bandIndex, parameter, value) once per pending slot, with its latest value
+        template <typename Function>
+        void drain(Function&& apply) noexcept
+        {
+            for (int parameter = 0; parameter < numParameters; ++parameter)
+            {
+                auto mask = pending[parameter].exchange(0, std::memory_order_acquire);
+
+                while (mask != 0)
+                {
+                    const int bandIndex = countTrailingZeros(mask);
+                    mask &= mask - 1;
+                    apply(bandIndex, static_cast<Parameter>(parameter),
+                          values[parameter][bandIndex].load(std::memory_order_relaxed));
+                }
+            }
+        }
+
+    private:
+        static int countTrailingZeros(std::uint32_t mask) noexcept
+        {
+            int index = 0;
+            while ((mask & 1u) == 0)
+            {
+                mask >>= 1;
+                ++index;
+            }
+            return index;
+        }
+
+        std::array<std::array<std::atomic<float>, Constants::maxBands>, numParameters> values{};
+        std::array<std::atomic<std::uint32_t>, numParameters> pending{};
+};
@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+    EQDaemon.cpp
+    Created: 17 Oct 2026 6:21:47pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "EQDaemon.h"
+
+juce::Result EQDaemon::parseCommandLine(const juce::StringArray& args, Options& options)
+{
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+    for (int i = 0; i < args.size(); ++i)
+    {
+        const auto& arg = args[i];
+        const bool hasValue = i + 1 < args.size();
+
+        if (arg == "--daemon")
+            continue;
+
+        if (arg == "--settings" && hasValue)
+            options.settingsFile = cwd.getChildFile(args[++i]);
+        else if (arg == "--device-type" && hasValue)
+            options.deviceType = args[++i];
+        else if (arg == "--device" && hasValue)
+            options.deviceName = args[++i];
+        else if (arg == "--sample-rate" && hasValue)
+            options.sampleRate = juce::jmax(0.0, args[++i].getDoubleValue());
+        else if (arg == "--buffer-size" && hasValue)
+            options.bufferSize = juce::jlimit(0, 65536, args[++i].getIntValue());
+        else if (arg == "--channels" && hasValue)
+            options.numChannels = juce::jlimit(1, 64, args[++i].getIntValue());
+        else if (arg == "--morph" && hasValue)
+            options.morphSeconds = juce::jlimit(0.0, 10.0, args[++i].getDoubleValue());
+        else if (arg == "--midi")
+            options.midi = true;
+        else if (arg == "--midi-channel" && hasValue)
+        {
+            options.midi = true;
+            options.midiChannel = juce::jlimit(0, 16, args[++i].getIntValue());
+        }
+        else if (arg == "--osc-port" && hasValue)
+            options.oscPort = juce::jlimit(0, 65535, args[++i].getIntValue());
+        else if (arg == "--timing-report" && hasValue)
+            options.timingReport = cwd.getChildFile(args[++i]);
+        else if (arg == "--trace" && hasValue)
+            options.trace = cwd.getChildFile(args[++i]);
+        else
+            return juce::Result::fail("Unknown or incomplete option: " + arg);
+    }
+
+    if (options.settingsFile == juce::File())
+        return juce::Result::fail("Missing --settings <file>");
+
+    return juce::Result::ok();
+}
+
+EQDaemon::EQDaemon(const Options& daemonOptions)
+    : options(daemonOptions)
+{
+}
+
+EQDaemon::~EQDaemon()
+{
+    stopTimer();
+    deviceManager.removeAudioCallback(this);
+    deviceManager.closeAudioDevice();
+
+    if (options.timingReport != juce::File())
+    {
+        performance.update();
+        const auto result = performance.writeReport(options.timingReport);
+        std::cout << (result.failed() ? result.getErrorMessage() : "Timing written to " + options.timingReport.getFullPathName()) << std::endl;
+    }
+
+    if (options.trace != juce::File())
+    {
+        const auto result = TraceRecorder::getInstance().writeTrace(options.trace);
+        std::cout << (result.failed() ? result.getErrorMessage() : "Trace written to " + options.trace.getFullPathName()) << std::endl;
+    }
+}
+
+juce::Result EQDaemon::start()
+{
+    // The first load has to succeed, later ones may fail and keep the running curve
+    auto result = reloadSettings(0.0);
+    if (result.failed())
+        return result;
+
+    auto error = deviceManager.initialise(options.numChannels, options.numChannels, nullptr, false);
+    if (error.isNotEmpty())
+        return juce::Result::fail(error);
+
+    if (options.deviceType.isNotEmpty())
+    {
+        deviceManager.setCurrentAudioDeviceType(options.deviceType, true);
+        if (deviceManager.getCurrentAudioDeviceType() != options.deviceType)
+            return juce::Result::fail("No such device type: " + options.deviceType);
+    }
+
+    auto setup = deviceManager.getAudioDeviceSetup();
+    if (options.deviceName.isNotEmpty())
+    {
+        setup.inputDeviceName = options.deviceName;
+        setup.outputDeviceName = options.deviceName;
+    }
+    if (options.sampleRate > 0.0)
+        setup.sampleRate = options.sampleRate;
+    if (options.bufferSize > 0)
+        setup.bufferSize = options.bufferSize;
+
+    error = deviceManager.setAudioDeviceSetup(setup, true);
+    if (error.isNotEmpty())
+        return juce::Result::fail(error);
+
+    auto* device = deviceManager.getCurrentAudioDevice();
+    if (device == nullptr)
+        return juce::Result::fail("No audio device could be opened");
+
+    if (options.midi)
+        std::cout << remoteControl.openMidiInputs(options.midiChannel) << " MIDI inputs open" << std::endl;
+
+    if (options.oscPort > 0)
+    {
+        result = remoteControl.openOsc(options.oscPort);
+        if (result.failed())
+            return result;
+    }
+
+    deviceManager.addAudioCallback(this);
+
+    std::cout << "Running on " << device->getName() << " (" << device->getTypeName() << "), "
+              << juce::String(device->getCurrentSampleRate(), 0) << " Hz, "
+              << device->getCurrentBufferSizeSamples() << " samples, watching "
+              << options.settingsFile.getFullPathName() << std::endl;
+
+    startTimer(options.pollIntervalMs);
+    return juce::Result::ok();
+}
+
+void EQDaemon::audioDeviceAboutToStart(juce::AudioIODevice* device)
+{
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = device->getCurrentSampleRate();
+    spec.maximumBlockSize = static_cast<juce::uint32>(device->getCurrentBufferSizeSamples());
+    spec.numChannels = static_cast<juce::uint32>(device->getActiveOutputChannels().countNumberOfSetBits());
+
+    eq.prepare(spec);
+    performance.prepare(spec.sampleRate);
+}
+
+void EQDaemon::audioDeviceIOCallbackWithContext(const float* const* inputChannelData, int numInputChannels,
+                                                float* const* outputChannelData, int numOutputChannels,
+                                                int numSamples, const juce::AudioIODeviceCallbackContext&)
+{
+    EQ_TRACE_SCOPE("audioDeviceIOCallback");
+
+    juce::ScopedNoDenormals noDenormals;
+
+    PerformanceMonitor::ScopedCallback timing(performance, numSamples);
+
+    // Input channel n goes to output channel n, outputs without an input stay silent
+    for (int ch = 0; ch < numOutputChannels; ++ch)
+    {
+        if (ch < numInputChannels && inputChannelData[ch] != nullptr)
+            juce::FloatVectorOperations::copy(outputChannelData[ch], inputChannelData[ch], numSamples);
+        else
+            juce::FloatVectorOperations::clear(outputChannelData[ch], numSamples);
+    }
+
+    juce::dsp::AudioBlock<float> block(outputChannelData, static_cast<size_t>(numOutputChannels),
+                                       static_cast<size_t>(numSamples));
+
+    PerformanceMonitor::ScopedEQ eqTiming(timing);
+    eq.process(block);
+}
+
+void EQDaemon::audioDeviceError(const juce::String& errorMessage)
+{
+    std::cerr << "Audio device error: " << errorMessage << std::endl;
+}
+
+void EQDaemon::timerCallback()
+{
+    performance.update();
+
+    const auto& file = options.settingsFile;
+    if (file.getLastModificationTime() == settingsModificationTime && file.getSize() == settingsSize)
+        return;
+
+    // A half-written file fails to parse; the next write changes the time stamp again
+    const auto result = reloadSettings(options.morphSeconds);
+    if (result.failed())
+        std::cerr << result.getErrorMessage() << ", keeping the current curve" << std::endl;
+    else
+        std::cout << "Reloaded " << file.getFileName() << std::endl;
+}
+
+juce::Result EQDaemon::reloadSettings(double morphSeconds)
+{
+    const auto& file = options.settingsFile;
+    settingsModificationTime = file.getLastModificationTime();
+    settingsSize = file.getSize();
+
+    auto bands = EQSettings::getDefaults();
+    const auto result = EQSettings::load(file, bands);
+    if (result.failed())
+        return result;
+
+    // Published through the triple buffer, the device keeps running
+    EQSettings::apply(bands, parameters, morphSeconds);
+    return juce::Result::ok();
+}
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    EQDaemon.h
+    Created: 17 Oct 2026 6:21:47pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "EQParameters.h"
+#include "EQProcessor.h"
+#include "EQSettings.h"
+#include "PerformanceMonitor.h"
+#include "RemoteControl.h"
+
+// Headless live mode for machines without a display: runs the EQ on a system
+// audio device, input straight to output, with no window, analyzer or repaints.
+// The message thread only wakes to poll the settings file, and a changed file
+// is morphed to on the audio thread without stopping the device.
+//
+//  MyProject --daemon --settings curve.json [--device-type <type>] [--device <name>]
+//            [--sample-rate N] [--buffer-size N] [--channels N] [--morph <seconds>]
+//            [--midi] [--midi-channel N] [--osc-port N] [--timing-report <file>] [--trace <file>]
+//
+// --midi and --osc-port turn on RemoteControl. --timing-report writes the callback timing
+// and --trace the last seconds of trace markers (see TraceRecorder) on exit.
+class EQDaemon : private juce::AudioIODeviceCallback,
+    private juce::Timer
+{
+    public:
+        struct Options
+        {
+            juce::File settingsFile;
+            juce::String deviceType;   // empty: the platform default
+            juce::String deviceName;   // input and output, empty: the default device
+            double sampleRate = 0.0;   // 0: the device's default
+            int bufferSize = 0;        // 0: the device's default
+            int numChannels = 2;
+            double morphSeconds = 0.05; // crossfade to a reloaded curve, so edits do not click
+            int pollIntervalMs = 500;
+            bool midi = false;
+            int midiChannel = 0;       // 0: all channels
+            int oscPort = 0;           // 0: no OSC
+            juce::File timingReport;
+            juce::File trace;
+        };
+
+        static bool isDaemonCommand(const juce::StringArray& args) { return args.contains("--daemon"); }
+        static juce::Result parseCommandLine(const juce::StringArray& args, Options& options);
+
+        explicit EQDaemon(const Options& options);
+        ~EQDaemon() override;
+
+        // Message thread. Loads the settings and opens the device.
+        juce::Result start();
+
+    private:
+        void audioDeviceIOCallbackWithContext(const float* const* inputChannelData, int numInputChannels,
+                                              float* const* outputChannelData, int numOutputChannels,
+                                              int numSamples, const juce::AudioIODeviceCallbackContext& context) override;
+        void audioDeviceAboutToStart(juce::AudioIODevice* device) override;
+        void audioDeviceStopped() override {}
+        void audioDeviceError(const juce::String& errorMessage) override;
+
+        // Drains the timing records, then reloads the settings file when its time stamp or size changed
+        void timerCallback() override;
+        juce::Result reloadSettings(double morphSeconds);
+
+        const Options options;
+
+        juce::AudioDeviceManager deviceManager;
+        EQProcessor eq;
+        EQParameters parameters{ eq };
+        RemoteControl remoteControl{ eq, parameters };
+        PerformanceMonitor performance;
+
+        juce::Time settingsModificationTime;
+        juce::int64 settingsSize = -1;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EQDaemon)
+};
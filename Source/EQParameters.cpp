@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    EQParameters.cpp
+    Created: 17 Oct 2026 2:14:52pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "EQParameters.h"
+
+EQParameters::EQParameters(EQProcessor& processor)
+    : eq(processor), curve(processor.getCurve())
+{
+    presets.fill(curve);
+}
+
+void EQParameters::setBand(int bandIndex, float freq, float gainDb, float Q)
+{
+    if (!isValidBand(bandIndex))
+        return;
+
+    auto& params = curve.bands[bandIndex];
+    params.freq = freq;
+    params.gainDb = gainDb;
+    params.Q = Q;
+
+    publish();
+}
+
+void EQParameters::setBandType(int bandIndex, EQProcessor::FilterType type)
+{
+    if (!isValidBand(bandIndex) || curve.bands[bandIndex].type == type)
+        return;
+
+    curve.bands[bandIndex].type = type;
+    publish();
+}
+
+void EQParameters::setBandEnabled(int bandIndex, bool shouldBeEnabled)
+{
+    if (!isValidBand(bandIndex) || curve.bands[bandIndex].enabled == shouldBeEnabled)
+        return;
+
+    curve.bands[bandIndex].enabled = shouldBeEnabled;
+    publish();
+}
+
+void EQParameters::setNumBands(int newNumBands)
+{
+    newNumBands = juce::jlimit(1, Constants::maxBands, newNumBands);
+    if (newNumBands == curve.numBands)
+        return;
+
+    curve.numBands = newNumBands;
+    publish();
+}
+
+void EQParameters::setCurve(const Curve& newCurve, double morphSeconds)
+{
+    curve = newCurve;
+    curve.numBands = juce::jlimit(1, Constants::maxBands, newCurve.numBands);
+    publish(morphSeconds);
+}
+
+void EQParameters::takeOverCurve(const Curve& playingCurve)
+{
+    curve = playingCurve;
+    curve.numBands = juce::jlimit(1, Constants::maxBands, playingCurve.numBands);
+    eq.syncCurve(curve);
+    ++version;
+}
+
+void EQParameters::switchToPreset(Slot slot, double morphSeconds)
+{
+    if (slot == activePreset)
+        return;
+
+    // Edits so far belong to the slot being left
+    storePreset(activePreset);
+    activePreset = slot;
+    recallPreset(slot, morphSeconds);
+}
+
+bool EQParameters::isValidBand(int bandIndex) const
+{
+    if (bandIndex >= 0 && bandIndex < Constants::maxBands)
+        return true;
+
+    DBG("ERROR: Unknown band index " << bandIndex);
+    return false;
+}
+
+void EQParameters::publish(double morphSeconds)
+{
+    eq.setCurve(curve, morphSeconds);
+    ++version;
+}
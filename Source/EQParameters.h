@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    EQParameters.h
+    Created: 17 Oct 2026 2:14:52pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Constants.h"
+#include "EQProcessor.h"
+
+// Band state of the EQ, owned here rather than by any view. The UI, settings
+// files and command-line modes all edit through this; every edit republishes
+// the whole curve to the processor. Views follow edits they did not make
+// (preset recalls, remote control) by polling getVersion().
+//
+// Two preset slots, A and B: one is active and collects the edits, switching
+// stores the current curve into it and recalls the other, either instantly or
+// morphing on the audio thread.
+//
+// Message thread only (or whichever single thread owns an offline instance).
+class EQParameters
+{
+    public:
+        enum Slot
+        {
+            A = 0,
+            B,
+            numSlots
+        };
+
+        using Curve = EQProcessor::Curve;
+        using BandParameters = EQProcessor::BandParameters;
+
+        explicit EQParameters(EQProcessor& processor);
+
+        // Band edits, applied at once
+        void setBand(int bandIndex, float freq, float gainDb, float Q);
+        void setBandType(int bandIndex, EQProcessor::FilterType type);
+        void setBandEnabled(int bandIndex, bool shouldBeEnabled);
+        void setNumBands(int newNumBands); // 1 .. Constants::maxBands
+        void setCurve(const Curve& newCurve, double morphSeconds = 0.0);
+
+        // Band values remote control already set on the audio thread: stored and shown like an edit,
+        // but not sent back as one (see EQProcessor::syncCurve)
+        void takeOverCurve(const Curve& playingCurve);
+
+        const Curve& getCurve() const { return curve; }
+        const BandParameters& getBand(int bandIndex) const { return curve.bands[bandIndex]; }
+        int getNumBands() const { return curve.numBands; }
+
+        // Presets
+        void switchToPreset(Slot slot, double morphSeconds = 0.0);
+        void storePreset(Slot slot) { presets[slot] = curve; }
+        void recallPreset(Slot slot, double morphSeconds = 0.0) { setCurve(presets[slot], morphSeconds); }
+        const Curve& getPreset(Slot slot) const { return presets[slot]; }
+        Slot getActivePreset() const { return activePreset; }
+
+        // Bumped by every change
+        juce::uint32 getVersion() const { return version; }
+
+    private:
+        bool isValidBand(int bandIndex) const;
+        void publish(double morphSeconds = 0.0);
+
+        EQProcessor& eq;
+        Curve curve;
+        std::array<Curve, numSlots> presets;
+        Slot activePreset = A;
+        juce::uint32 version = 0;
+};
@@ -10,104 +10,597 @@
 
 #include "EQProcessor.h"
 
-EQProcessor::EQProcessor() {}
+EQProcessor::EQProcessor()
+{
+    // Start from the default curve so the UI and the audio thread agree before the first edit
+    editState.curve = getDefaultCurve();
+
+    designAllBands(editState);
+    activeState = editState;
+    soundingCurve = editState.curve;
+}
 
 void EQProcessor::prepare(const juce::dsp::ProcessSpec& spec)
 {
+    prepare(spec, juce::AudioChannelSet::canonicalChannelSet(static_cast<int>(spec.numChannels)));
+}
+
+void EQProcessor::prepare(const juce::dsp::ProcessSpec& spec, const juce::AudioChannelSet& layout)
+{
+    EQ_TRACE_SCOPE("EQProcessor::prepare");
+
+    jassert(layout.size() == static_cast<int>(spec.numChannels));
+
     // Get the sample rate of the spec.
     sampleRate = spec.sampleRate;
-    leftChannel.prepare(spec);
-    rightChannel.prepare(spec);
+
+    // Filter everything but the LFE feeds
+    std::vector<int> filteredChannels;
+    for (int ch = 0; ch < static_cast<int>(spec.numChannels); ++ch)
+    {
+        const auto type = layout.getTypeOfChannel(ch);
+        if (type != juce::AudioChannelSet::LFE && type != juce::AudioChannelSet::LFE2)
+            filteredChannels.push_back(ch);
+    }
+
+    cascade.prepare(filteredChannels, static_cast<int>(spec.maximumBlockSize));
+
+    // Every channel goes through the oversampler, LFE included, so all of them get the same latency
+    for (int order = 1; order <= maxOversamplingOrder; ++order)
+    {
+        oversamplers[order] = std::make_unique<juce::dsp::Oversampling<float>>(
+            spec.numChannels, static_cast<size_t>(order),
+            juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
+            false,  // cheaper filters; the stop band is still well below audibility
+            true);  // whole-sample latency, so it can be compensated exactly
+        oversamplers[order]->initProcessing(spec.maximumBlockSize);
+    }
+
+    linearPhase.prepare(spec, filteredChannels);
+
+    for (auto& measurer : loadMeasurers)
+        measurer.reset(spec.sampleRate, static_cast<int>(spec.maximumBlockSize));
+    linearPhaseLoadMeasurer.reset(spec.sampleRate, static_cast<int>(spec.maximumBlockSize));
+
+    // Pick up anything published so far, then redesign it at the new rate
+    if (snapshots.pull())
+    {
+        const auto automatedCurve = activeState.curve;
+        activeState = snapshots.getReadBuffer();
+
+        if (curveFromAutomation)
+            activeState.curve = automatedCurve;
+    }
+
+    activeState.sampleRate = spec.sampleRate;
+    designAllBands(activeState);
+
+    // A morph in progress ends here, the device is restarting anyway
+    morphRemaining = 0;
+    playingMorphRequest = activeState.morphRequest;
+    soundingCurve = activeState.curve;
+
+    loadCoefficients(activeState.curve, activeState.coefficients);
+    activateProcessingMode();
+    linearPhase.acknowledge(activeState.linearPhaseRequest);
 }
 
 void EQProcessor::process(juce::AudioBuffer<float>& buffer)
 {
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> leftContext(block.getSingleChannelBlock(0));
-    juce::dsp::ProcessContextReplacing<float> rightContext(block.getSingleChannelBlock(1));
-
-    leftChannel.process(leftContext);
-    rightChannel.process(rightContext);
+    process(juce::dsp::AudioBlock<float>(buffer));
 }
 
-void EQProcessor::updateEQ(int bandIndex, float freq, float gainDb, float Q)
+void EQProcessor::process(const juce::dsp::AudioBlock<float>& block)
 {
-    switch (bandIndex)
+    EQ_TRACE_SCOPE("EQProcessor::process");
+
+    // The flush-to-zero mode is per thread: renderers and stream workers call in here directly
+    juce::ScopedNoDenormals noDenormals;
+
+    // One atomic load per block unless the UI has published something new
+    if (snapshots.pull())
     {
-        case HighPass:
+        const int previousOrder = activeState.oversamplingOrder;
+        const bool wasLinearPhase = activeState.linearPhase;
+        const auto playingCurve = activeState.curve;
+        const auto playingEdits = activeState.bandEdits;
+        activeState = snapshots.getReadBuffer();
+
+        bool needsRedesign = false;
+
+        if (curveFromAutomation)
         {
-            auto coeffs = Coeffs::makeHighPass(sampleRate, freq, Q);
-            updateCoefficients(leftChannel.get<HighPass>().coefficients, coeffs);
-            updateCoefficients(rightChannel.get<HighPass>().coefficients, coeffs);
-            break;
+            // The host's curve stays, only the processing settings are taken over
+            activeState.curve = playingCurve;
+            activeState.morphSeconds = 0.0;
+            needsRedesign = true;
         }
-
-        case Peak1:
+        else if (controlQueue != nullptr)
         {
-            auto coeffs = Coeffs::makePeakFilter(sampleRate, freq, Q, juce::Decibels::decibelsToGain(gainDb));
-            updateCoefficients(leftChannel.get<Peak1>().coefficients, coeffs);
-            updateCoefficients(rightChannel.get<Peak1>().coefficients, coeffs);
-            break;
+            // Bands not edited since keep what remote control set here, the message thread may lag behind
+            for (int i = 0; i < Constants::maxBands; ++i)
+            {
+                if (activeState.bandEdits[i] == playingEdits[i] && !isSameBand(activeState.curve.bands[i], playingCurve.bands[i]))
+                {
+                    activeState.curve.bands[i] = playingCurve.bands[i];
+                    needsRedesign = true;
+                }
+            }
         }
 
-        case Peak2:
+        // Published before prepare() changed the rate
+        const auto currentRate = sampleRate.load(std::memory_order_relaxed);
+        if (activeState.sampleRate != currentRate)
         {
-            auto coeffs = Coeffs::makePeakFilter(sampleRate, freq, Q, juce::Decibels::decibelsToGain(gainDb));
-            updateCoefficients(leftChannel.get<Peak2>().coefficients, coeffs);
-            updateCoefficients(rightChannel.get<Peak2>().coefficients, coeffs);
-            break;
+            activeState.sampleRate = currentRate;
+            needsRedesign = true;
         }
 
-        case Peak3:
+        if (needsRedesign)
+            designAllBands(activeState);
+
+        const bool isNewMorph = activeState.morphRequest != playingMorphRequest;
+        playingMorphRequest = activeState.morphRequest;
+
+        // Glide from what is playing now, so an interrupted morph carries on from where it was.
+        // A publish that asks for no new glide (mode, rate, sync) lets one in progress run on to its curve.
+        // The FIR has no per-sample coefficients, its kernel crossfade is the morph.
+        const bool startsMorph = isNewMorph && activeState.morphSeconds > 0.0 && !activeState.linearPhase;
+        const bool keepsMorph = !isNewMorph && morphRemaining > 0 && !activeState.linearPhase;
+
+        if (startsMorph)
         {
-            auto coeffs = Coeffs::makePeakFilter(sampleRate, freq, Q, juce::Decibels::decibelsToGain(gainDb));
-            updateCoefficients(leftChannel.get<Peak3>().coefficients, coeffs);
-            updateCoefficients(rightChannel.get<Peak3>().coefficients, coeffs);
-            break;
+            morphStart = soundingCurve;
+            morphLength = juce::jmax(1, static_cast<int>(activeState.morphSeconds * currentRate));
+            morphRemaining = morphLength;
         }
-
-        case Peak4:
+        else if (!keepsMorph)
         {
-            auto coeffs = Coeffs::makePeakFilter(sampleRate, freq, Q, juce::Decibels::decibelsToGain(gainDb));
-            updateCoefficients(leftChannel.get<Peak4>().coefficients, coeffs);
-            updateCoefficients(rightChannel.get<Peak4>().coefficients, coeffs);
-            break;
+            morphRemaining = 0;
+            soundingCurve = activeState.curve;
+            loadCoefficients(activeState.curve, activeState.coefficients);
         }
 
-        case LowPass:
+        if (activeState.oversamplingOrder != previousOrder || activeState.linearPhase != wasLinearPhase)
+            activateProcessingMode();
+
+        // From here on the linear-phase engines are only touched if this state uses them
+        linearPhase.acknowledge(activeState.linearPhaseRequest);
+    }
+
+    if (controlQueue != nullptr && controlQueue->hasPending())
+        applyRemoteEdits();
+
+    if (activeState.linearPhase)
+    {
+        juce::AudioProcessLoadMeasurer::ScopedTimer timer(linearPhaseLoadMeasurer, static_cast<int>(block.getNumSamples()));
+        linearPhase.process(block);
+        return;
+    }
+
+    juce::AudioProcessLoadMeasurer::ScopedTimer timer(loadMeasurers[activeState.oversamplingOrder], static_cast<int>(block.getNumSamples()));
+
+    if (morphRemaining == 0)
+    {
+        processFilters(block);
+        return;
+    }
+
+    // Redesign every morphStepSize samples while gliding
+    const auto numSamples = block.getNumSamples();
+    for (size_t start = 0; start < numSamples; start += morphStepSize)
+    {
+        const auto length = juce::jmin(static_cast<size_t>(morphStepSize), numSamples - start);
+        advanceMorph(static_cast<int>(length));
+        processFilters(block.getSubBlock(start, length));
+    }
+}
+
+void EQProcessor::process(const juce::dsp::AudioBlock<float>& block, const AutomationPoint* points, int numPoints)
+{
+    jassert(curveFromAutomation || numPoints == 0);
+
+    const auto numSamples = static_cast<int>(block.getNumSamples());
+    int start = 0;
+
+    // Split only where the curve changes, each segment runs at full block speed
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const int offset = juce::jlimit(start, numSamples, points[i].sampleOffset);
+        if (offset > start)
+            process(block.getSubBlock((size_t)start, (size_t)(offset - start)));
+
+        applyAutomation(*points[i].curve);
+        start = offset;
+    }
+
+    if (start < numSamples)
+        process(block.getSubBlock((size_t)start, (size_t)(numSamples - start)));
+}
+
+void EQProcessor::applyAutomation(const Curve& curve)
+{
+    if (!updateActiveCurve(curve))
+        return;
+
+    // The host has the last word over any glide
+    morphRemaining = 0;
+    soundingCurve = activeState.curve;
+    loadCoefficients(activeState.curve, activeState.coefficients);
+}
+
+bool EQProcessor::updateActiveCurve(const Curve& curve)
+{
+    // Gather the bands that moved into one design batch
+    std::array<int, Constants::maxBands> changed;
+    std::array<FilterType, Constants::maxBands> types;
+    std::array<float, Constants::maxBands> freqs, gains, Qs;
+    int numChanged = 0;
+
+    for (int i = 0; i < Constants::maxBands; ++i)
+    {
+        const auto& band = curve.bands[i];
+        if (isSameBand(band, activeState.curve.bands[i]))
+            continue;
+
+        activeState.curve.bands[i] = band;
+        changed[numChanged] = i;
+        types[numChanged] = band.type;
+        freqs[numChanged] = band.freq;
+        gains[numChanged] = band.gainDb;
+        Qs[numChanged] = band.Q;
+        ++numChanged;
+    }
+
+    const int numBands = juce::jlimit(1, Constants::maxBands, curve.numBands);
+    if (numChanged == 0 && numBands == activeState.curve.numBands)
+        return false;
+
+    activeState.curve.numBands = numBands;
+
+    std::array<BiquadCoefficients, Constants::maxBands> designed;
+    CoefficientDesigner::design(numChanged, types.data(), freqs.data(), gains.data(), Qs.data(),
+                                getDesignRate(activeState), designed.data());
+
+    for (int k = 0; k < numChanged; ++k)
+        activeState.coefficients[changed[k]] = designed[k];
+
+    return true;
+}
+
+void EQProcessor::applyRemoteEdits()
+{
+    jassert(!curveFromAutomation);
+
+    auto curve = activeState.curve;
+    controlQueue->drain([&curve](int bandIndex, ControlQueue::Parameter parameter, float value)
+    {
+        setBandParameter(curve.bands[bandIndex], parameter, value);
+    });
+
+    // Only the bands that moved are redesigned, same as host automation
+    if (!updateActiveCurve(curve))
+        return;
+
+    // A glide in progress (e.g. an A/B morph) carries on towards the edited target and lands on it
+    if (morphRemaining > 0)
+        return;
+
+    soundingCurve = activeState.curve;
+    loadCoefficients(activeState.curve, activeState.coefficients);
+}
+
+void EQProcessor::processFilters(const juce::dsp::AudioBlock<float>& block)
+{
+    const int order = activeState.oversamplingOrder;
+
+    if (order == 0 || oversamplers[order] == nullptr)
+    {
+        cascade.process(block);
+        return;
+    }
+
+    auto& oversampler = *oversamplers[order];
+    cascade.process(oversampler.processSamplesUp(block));
+
+    auto output = block;
+    oversampler.processSamplesDown(output);
+}
+
+void EQProcessor::advanceMorph(int numSamples)
+{
+    if (morphRemaining == 0)
+        return;
+
+    morphRemaining = juce::jmax(0, morphRemaining - numSamples);
+
+    // Done: land exactly on the published design
+    if (morphRemaining == 0)
+    {
+        soundingCurve = activeState.curve;
+        loadCoefficients(activeState.curve, activeState.coefficients);
+        return;
+    }
+
+    const float position = 1.0f - static_cast<float>(morphRemaining) / static_cast<float>(morphLength);
+    interpolateCurves(morphStart, activeState.curve, position, soundingCurve);
+
+    designCurve(soundingCurve, getDesignRate(activeState), morphCoefficients.data());
+    loadCoefficients(soundingCurve, morphCoefficients);
+}
+
+EQProcessor::BandParameters EQProcessor::getDefaultBand(int bandIndex)
+{
+    BandParameters params;
+    params.gainDb = Constants::defaultGain;
+
+    if (bandIndex < Constants::defaultNumBands)
+    {
+        params.freq = Constants::defaultFrequencies[bandIndex];
+        params.Q = Constants::defaultQs[bandIndex];
+
+        if (bandIndex == 0)
+            params.type = CoefficientDesigner::HighPass;
+        else if (bandIndex == Constants::defaultNumBands - 1)
+            params.type = CoefficientDesigner::LowPass;
+
+        return params;
+    }
+
+    // Golden-ratio steps over 40 Hz .. 16 kHz, so added bands never land on top of each other
+    const float position = std::fmod(0.5f + 0.618034f * static_cast<float>(bandIndex), 1.0f);
+    params.freq = 40.0f * std::pow(400.0f, position);
+    params.Q = 1.0f;
+    return params;
+}
+
+EQProcessor::Curve EQProcessor::getDefaultCurve()
+{
+    Curve curve;
+    for (int i = 0; i < Constants::maxBands; ++i)
+        curve.bands[i] = getDefaultBand(i);
+
+    return curve;
+}
+
+void EQProcessor::setBandParameter(BandParameters& band, ControlQueue::Parameter parameter, float value)
+{
+    switch (parameter)
+    {
+        case ControlQueue::Frequency: band.freq = value; break;
+        case ControlQueue::Gain:      band.gainDb = value; break;
+        case ControlQueue::Q:         band.Q = value; break;
+        default: break;
+    }
+}
+
+bool EQProcessor::isSameBand(const BandParameters& a, const BandParameters& b)
+{
+    return a.freq == b.freq && a.gainDb == b.gainDb && a.Q == b.Q && a.type == b.type && a.enabled == b.enabled;
+}
+
+bool EQProcessor::isBandActive(const Curve& curve, int bandIndex)
+{
+    const auto& params = curve.bands[bandIndex];
+
+    return bandIndex < curve.numBands
+        && params.enabled
+        && !(params.type == CoefficientDesigner::Peak && std::abs(params.gainDb) < unityGainThresholdDb);
+}
+
+void EQProcessor::setCurve(const Curve& newCurve, double morphSeconds)
+{
+    EQ_TRACE_SCOPE("EQProcessor::setCurve");
+
+    jassert(newCurve.numBands >= 1 && newCurve.numBands <= Constants::maxBands);
+
+    editState.sampleRate = sampleRate.load();
+
+    for (int i = 0; i < Constants::maxBands; ++i)
+        if (!isSameBand(newCurve.bands[i], editState.curve.bands[i]))
+            ++editState.bandEdits[i];
+
+    editState.curve = newCurve;
+    editState.curve.numBands = juce::jlimit(1, Constants::maxBands, newCurve.numBands);
+    editState.morphSeconds = juce::jmax(0.0, morphSeconds);
+    ++editState.morphRequest;
+    designAllBands(editState);
+
+    publishEditState();
+}
+
+void EQProcessor::syncCurve(const Curve& playingCurve)
+{
+    EQ_TRACE_SCOPE("EQProcessor::syncCurve");
+
+    // Same edit counts, so this only updates the UI state, the linear-phase kernel and the band count
+    editState.sampleRate = sampleRate.load();
+    editState.curve = playingCurve;
+    editState.curve.numBands = juce::jlimit(1, Constants::maxBands, playingCurve.numBands);
+    designAllBands(editState);
+
+    publishEditState();
+}
+
+void EQProcessor::syncSampleRate()
+{
+    const auto currentRate = sampleRate.load();
+    if (editState.sampleRate == currentRate)
+        return;
+
+    editState.sampleRate = currentRate;
+    designAllBands(editState);
+    publishEditState();
+}
+
+void EQProcessor::setLinearPhase(bool shouldBeLinearPhase)
+{
+    if (shouldBeLinearPhase == editState.linearPhase)
+        return;
+
+    editState.sampleRate = sampleRate.load();
+    editState.linearPhase = shouldBeLinearPhase;
+    editState.linearPhaseRequest = shouldBeLinearPhase ? linearPhase.activate() : linearPhase.deactivate();
+    designAllBands(editState);
+    publishEditState();
+}
+
+void EQProcessor::setOversamplingOrder(int order)
+{
+    order = juce::jlimit(0, maxOversamplingOrder, order);
+    if (order == editState.oversamplingOrder)
+        return;
+
+    editState.sampleRate = sampleRate.load();
+    editState.oversamplingOrder = order;
+    designAllBands(editState);
+    publishEditState();
+}
+
+float EQProcessor::getMagnitudeForFrequency(double frequency, double sampleRate) const
+{
+    const auto omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    const auto z1 = std::polar(1.0, -omega);
+    const auto z2 = z1 * z1;
+
+    std::complex<double> result(1.0, 0.0);
+
+    for (int i = 0; i < editState.curve.numBands; ++i)
+    {
+        if (!isBandActive(editState.curve, i))
+            continue;
+
+        const auto& c = editState.coefficients[i];
+        const auto numerator = (double)c.b0 + (double)c.b1 * z1 + (double)c.b2 * z2;
+        const auto denominator = 1.0 + (double)c.a1 * z1 + (double)c.a2 * z2;
+        result *= numerator / denominator;
+    }
+
+    return static_cast<float>(std::abs(result));
+}
+
+// ============== Helper functions ============== //
+
+void EQProcessor::designCurve(const Curve& curve, double sampleRate, BiquadCoefficients* coefficients)
+{
+    // One batch, cheap enough for the audio thread. Only bands inside the count.
+    std::array<FilterType, Constants::maxBands> types;
+    std::array<float, Constants::maxBands> freqs, gains, Qs;
+
+    for (int i = 0; i < curve.numBands; ++i)
+    {
+        types[i] = curve.bands[i].type;
+        freqs[i] = curve.bands[i].freq;
+        gains[i] = curve.bands[i].gainDb;
+        Qs[i] = curve.bands[i].Q;
+    }
+
+    CoefficientDesigner::design(curve.numBands, types.data(), freqs.data(), gains.data(), Qs.data(),
+                                sampleRate, coefficients);
+}
+
+void EQProcessor::designAllBands(Snapshot& snapshot)
+{
+    // Bands past the count are designed too, so the UI can show them and raising the count needs no redesign
+    Curve everyBand = snapshot.curve;
+    everyBand.numBands = Constants::maxBands;
+    designCurve(everyBand, getDesignRate(snapshot), snapshot.coefficients.data());
+}
+
+void EQProcessor::interpolateCurves(const Curve& from, const Curve& to, float position, Curve& result)
+{
+    // Bands the two curves do not share are held off in the one that lacks them
+    result.numBands = juce::jmax(from.numBands, to.numBands);
+
+    auto logInterpolate = [position](float a, float b) { return a * std::pow(b / a, position); };
+
+    for (int i = 0; i < result.numBands; ++i)
+    {
+        auto a = from.bands[i];
+        auto b = to.bands[i];
+        a.enabled = a.enabled && i < from.numBands;
+        b.enabled = b.enabled && i < to.numBands;
+
+        auto& band = result.bands[i];
+
+        if (a.type != b.type || (a.type != CoefficientDesigner::Peak && a.enabled != b.enabled))
         {
-            auto coeffs = Coeffs::makeLowPass(sampleRate, freq, Q);
-            updateCoefficients(leftChannel.get<LowPass>().coefficients, coeffs);
-            updateCoefficients(rightChannel.get<LowPass>().coefficients, coeffs);
-            break;
+            // No continuous path between these, switch halfway
+            band = position < 0.5f ? a : b;
+            continue;
         }
 
-        default:
+        if (a.type == CoefficientDesigner::Peak && a.enabled != b.enabled)
         {
-            DBG("ERROR: Unknown band index " << bandIndex);
-            break;
+            // A peak that is off is the same peak at 0 dB: fade its gain in or out in place
+            const auto& present = a.enabled ? a : b;
+            band = present;
+            band.gainDb = a.enabled ? a.gainDb * (1.0f - position) : b.gainDb * position;
+            continue;
         }
+
+        // Frequency and Q glide evenly on a log scale, gain in dB
+        band = b;
+        band.freq = logInterpolate(a.freq, b.freq);
+        band.Q = logInterpolate(a.Q, b.Q);
+        band.gainDb = a.gainDb + (b.gainDb - a.gainDb) * position;
     }
 }
 
-float EQProcessor::getMagnitudeForFrequency(double frequency, double sampleRate) const
+void EQProcessor::publishEditState()
 {
-    std::complex<double> result(1.0, 0.0);
+    snapshots.getWriteBuffer() = editState;
+    snapshots.publish();
 
-    auto accumulateMag = [&](const Filter& filter)
-        {
-            const Coeffs* coeffs = filter.coefficients.get();
-            if (coeffs != nullptr)
-                result *= coeffs->getMagnitudeForFrequency(frequency, sampleRate);
-        };
-
-    // assume symmetry, can use left channel only
-    accumulateMag(leftChannel.get<HighPass>());
-    accumulateMag(leftChannel.get<Peak1>());
-    accumulateMag(leftChannel.get<Peak2>());
-    accumulateMag(leftChannel.get<Peak3>());
-    accumulateMag(leftChannel.get<Peak4>());
-    accumulateMag(leftChannel.get<LowPass>());
+    // Kernels are only designed while they are in use. Inactive bands go in as identities.
+    if (editState.linearPhase)
+    {
+        LinearPhaseEQ::Coefficients effective;
+        for (int i = 0; i < Constants::maxBands; ++i)
+            effective[i] = isBandActive(editState.curve, i) ? editState.coefficients[i] : BiquadCoefficients{};
 
-    return static_cast<float>(std::abs(result));
-}
\ No newline at end of file
+        linearPhase.requestDesign(effective, getDesignRate(editState));
+    }
+}
+
+void EQProcessor::loadCoefficients(const Curve& curve, const std::array<BiquadCoefficients, Constants::maxBands>& coefficients)
+{
+    // Only active bands run: a typical 3-band correction costs three sections, not six
+    std::array<int, Constants::maxBands> active;
+    int numActive = 0;
+
+    for (int i = 0; i < curve.numBands; ++i)
+    {
+        if (!isBandActive(curve, i))
+            continue;
+
+        cascade.setCoefficients(i, coefficients[i]);
+        active[numActive++] = i;
+    }
+
+    cascade.setActiveSections(active.data(), numActive);
+}
+
+void EQProcessor::activateProcessingMode()
+{
+    if (activeState.linearPhase)
+    {
+        linearPhase.reset();
+        latencySamples.store(static_cast<float>(linearPhase.getLatencyInSamples()), std::memory_order_relaxed);
+        return;
+    }
+
+    // Old filter state belongs to a different rate
+    cascade.reset();
+
+    const int order = activeState.oversamplingOrder;
+    if (oversamplers[order] != nullptr)
+    {
+        oversamplers[order]->reset();
+        latencySamples.store(oversamplers[order]->getLatencyInSamples(), std::memory_order_relaxed);
+    }
+    else
+    {
+        latencySamples.store(0.0f, std::memory_order_relaxed);
+    }
+}
@@ -11,50 +11,204 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "BiquadCascade.h"
+#include "CoefficientDesigner.h"
+#include "Constants.h"
+#include "ControlQueue.h"
+#include "LinearPhaseEQ.h"
+#include "TraceRecorder.h"
+#include "TripleBuffer.h"
 
 class EQProcessor
 {
     public:
 
-        enum Band
+        using FilterType = CoefficientDesigner::FilterType;
+
+        // User settings of one band
+        struct BandParameters
+        {
+            float freq = 1000.0f;
+            float gainDb = 0.0f;
+            float Q = 0.707f;
+            FilterType type = CoefficientDesigner::Peak;
+            bool enabled = true;
+        };
+
+        // Peaks at 0 dB are dropped from the cascade below this, they are exact identities anyway
+        static constexpr float unityGainThresholdDb = 1.0e-3f;
+
+        // Band i of a fresh processor: high-pass, four peaks and low-pass, then more peaks spread over the spectrum
+        static BandParameters getDefaultBand(int bandIndex);
+
+        // Every band setting. Bands past numBands keep their settings for when the count goes back up.
+        struct Curve
+        {
+            int numBands = Constants::defaultNumBands;
+            std::array<BandParameters, Constants::maxBands> bands;
+        };
+
+        static Curve getDefaultCurve();
+
+        // True if the band is processed: inside the count, enabled and not a peak at unity gain
+        static bool isBandActive(const Curve& curve, int bandIndex);
+        static bool isSameBand(const BandParameters& a, const BandParameters& b);
+        static void setBandParameter(BandParameters& band, ControlQueue::Parameter parameter, float value);
+
+        // Oversampling order: the cascade runs at sampleRate * 2^order (1x, 2x, 4x, 8x)
+        static constexpr int maxOversamplingOrder = 3;
+
+        // Complete state of all bands, handed to the audio thread as one unit
+        struct Snapshot
+        {
+            double sampleRate = 44100.0;
+            int oversamplingOrder = 0;
+            bool linearPhase = false;
+            juce::int64 linearPhaseRequest = 0; // acknowledged to LinearPhaseEQ once playing
+            Curve curve;
+            std::array<BiquadCoefficients, Constants::maxBands> coefficients;
+
+            // Counts the edits of each band, so the audio thread can tell them from bands it moved itself
+            std::array<juce::uint32, Constants::maxBands> bandEdits{};
+
+            // Seconds for the audio thread to glide from the curve it is playing to this one, 0 to switch at once.
+            // Counted per setCurve(), so a glide is started once even if later publishes (mode, rate or
+            // remote sync) replace this snapshot before the audio thread picks it up.
+            double morphSeconds = 0.0;
+            juce::uint32 morphRequest = 0;
+        };
+
+        // A curve that takes over at sampleOffset within the next process() call
+        struct AutomationPoint
         {
-            HighPass = 0,
-            Peak1,
-            Peak2,
-            Peak3,
-            Peak4,
-            LowPass
+            int sampleOffset = 0;
+            const Curve* curve = nullptr;
         };
 
         EQProcessor();
 
+        // Not real-time safe. Every channel of the layout is filtered except LFE channels,
+        // which pass through untouched. Without a layout the canonical one for spec.numChannels is used.
+        void prepare(const juce::dsp::ProcessSpec& spec, const juce::AudioChannelSet& layout);
         void prepare(const juce::dsp::ProcessSpec& spec);
-        void process(juce::AudioBuffer<float>& buffer);
-        float getSampleRate() const { return sampleRate; }
-
-        void updateEQ(int bandIndex, float freq, float gainDb, float Q);
 
+        // Real-time safe, processes in place with denormals flushed. Channel groups whose input
+        // is silent skip the filters once their tails have died away (see BiquadCascade).
+        void process(juce::AudioBuffer<float>& buffer);
+        void process(const juce::dsp::AudioBlock<float>& block);
+
+        // Real-time safe. For hosts that own the parameters (see setCurveFromAutomation): the block is
+        // split at each point, sorted by offset, and only bands that differ from the playing curve are
+        // redesigned there. No points costs the same as process(block).
+        void process(const juce::dsp::AudioBlock<float>& block, const AutomationPoint* points, int numPoints);
+
+        // Not real-time safe, call before prepare(). With automation on, the curve comes only from
+        // AutomationPoints; published curves still drive the UI state and the linear-phase kernel.
+        void setCurveFromAutomation(bool shouldUseAutomation) { curveFromAutomation = shouldUseAutomation; }
+        bool isCurveFromAutomation() const { return curveFromAutomation; }
+
+        // Not real-time safe, call before prepare() and detach (nullptr) before the queue goes away.
+        // process() drains it at the start of every block: each band that was touched is redesigned
+        // once with its latest values, however many edits arrived. The owner takes the same edits over
+        // on the message thread with syncCurve(), so UI state and the linear-phase kernel follow.
+        void setControlQueue(ControlQueue* queue) { controlQueue = queue; }
+        float getSampleRate() const { return static_cast<float>(sampleRate.load()); }
+
+        // Any thread. Delay added by the active oversampling filters, in samples at the device rate.
+        float getLatencyInSamples() const { return latencySamples.load(std::memory_order_relaxed); }
+
+        // Any thread. Share of the real-time budget process() used the last time this order was active.
+        double getProcessingLoad(int order) const { return loadMeasurers[order].getLoadAsProportion(); }
+        double getLinearPhaseLoad() const { return linearPhaseLoadMeasurer.getLoadAsProportion(); }
+
+        // Message thread only (or whichever single thread owns an offline instance).
+        // Never touches the live filters: the new curve is published and picked up
+        // by process() at the start of its next block. With morphSeconds > 0 the audio
+        // thread glides there from whatever it is playing, redesigning at control rate.
+        // Band state is owned by EQParameters, which calls this after every edit.
+        void setCurve(const Curve& newCurve, double morphSeconds = 0.0);
+
+        // Message thread only. Like setCurve(), for band values the audio thread already plays
+        // (remote control): the audio thread keeps its own values for every band not edited since.
+        void syncCurve(const Curve& playingCurve);
+        const Curve& getCurve() const { return editState.curve; }
+        int getNumBands() const { return editState.curve.numBands; }
+        const BandParameters& getBandParameters(int bandIndex) const { return editState.curve.bands[bandIndex]; }
+        const BiquadCoefficients& getBandCoefficients(int bandIndex) const { return editState.coefficients[bandIndex]; }
+
+        // Message thread only. Redesigns the published state if prepare() changed the sample rate.
+        void syncSampleRate();
+
+        // Message thread only. Switches oversampling with the next block; the filters restart from silence.
+        void setOversamplingOrder(int order);
+        int getOversamplingOrder() const { return editState.oversamplingOrder; }
+
+        // Message thread only. Runs the same curve as a linear-phase FIR (replaces oversampling while on).
+        // The kernel is redesigned in the background after every edit and crossfaded in.
+        void setLinearPhase(bool shouldBeLinearPhase);
+        bool isLinearPhase() const { return editState.linearPhase; }
+
+        // Message thread only. Rate the edited coefficients were designed at (device rate times oversampling).
+        double getDesignSampleRate() const { return getDesignRate(editState); }
+
+        // Message thread only (reads the edited state, not the live filters).
+        // sampleRate should be getDesignSampleRate().
         float getMagnitudeForFrequency(double frequency, double sampleRate) const;
 
     private:
 
-        using Filter = juce::dsp::IIR::Filter<float>;
+        // All active bands for every filtered channel, in one pass
+        BiquadCascade cascade;
 
-        using CoeffsPtr = Filter::CoefficientsPtr;
+        // fall back sample rate
+        std::atomic<double> sampleRate{ 44100.0 };
 
-        using Coeffs = juce::dsp::IIR::Coefficients<float>;
+        // Polyphase IIR half-band stages around the cascade, one per order (none at 1x).
+        // All are built in prepare() so switching on the audio thread never allocates.
+        std::array<std::unique_ptr<juce::dsp::Oversampling<float>>, maxOversamplingOrder + 1> oversamplers;
+        std::atomic<float> latencySamples{ 0.0f };
+        std::array<juce::AudioProcessLoadMeasurer, maxOversamplingOrder + 1> loadMeasurers;
 
-        // Mono chain
-        using FilterChain = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter, Filter, Filter>;
+        // Linear-phase mode
+        LinearPhaseEQ linearPhase;
+        juce::AudioProcessLoadMeasurer linearPhaseLoadMeasurer;
 
-        // Use two chains
-        FilterChain leftChannel, rightChannel;
+        // Message thread: latest edited state
+        Snapshot editState;
 
-        // fall back sample rate
-        float sampleRate = 44100.0f;
+        // Lock-free handoff, latest edit wins
+        TripleBuffer<Snapshot> snapshots;
 
-        // DSP -- Change bands
-        void EQProcessor::updateCoefficients(CoeffsPtr& old, CoeffsPtr& replacements) { *old = *replacements; }
-        
+        // Audio thread: latest state picked up from the message thread
+        Snapshot activeState;
+
+        // Audio thread: the curve the filters are playing, which lags activeState while morphing
+        static constexpr int morphStepSize = 32; // samples between redesigns at the device rate
+        Curve soundingCurve, morphStart;
+        std::array<BiquadCoefficients, Constants::maxBands> morphCoefficients;
+        int morphLength = 0, morphRemaining = 0;
+        juce::uint32 playingMorphRequest = 0;
+
+        bool curveFromAutomation = false;
+        ControlQueue* controlQueue = nullptr;
 
-};
\ No newline at end of file
+        // DSP -- Design bands (allocation free)
+        // The linear-phase kernel samples a curve designed at the highest oversampled rate, free of cramping
+        static double getDesignRate(const Snapshot& snapshot)
+        {
+            return snapshot.sampleRate * (1 << (snapshot.linearPhase ? maxOversamplingOrder : snapshot.oversamplingOrder));
+        }
+        static void designCurve(const Curve& curve, double sampleRate, BiquadCoefficients* coefficients);
+        static void designAllBands(Snapshot& snapshot);
+        static void interpolateCurves(const Curve& from, const Curve& to, float position, Curve& result);
+
+        // DSP -- Change bands
+        void publishEditState();
+        void loadCoefficients(const Curve& curve, const std::array<BiquadCoefficients, Constants::maxBands>& coefficients);
+        void activateProcessingMode();
+        void advanceMorph(int numSamples);
+        void applyAutomation(const Curve& curve);
+        bool updateActiveCurve(const Curve& curve);
+        void applyRemoteEdits();
+        void processFilters(const juce::dsp::AudioBlock<float>& block);
+};
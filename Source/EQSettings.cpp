@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    EQSettings.cpp
+    Created: 16 Oct 2026 1:41:05pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "EQSettings.h"
+
+namespace
+{
+    const char* const typeNames[] = { "highpass", "peak", "lowpass" };
+}
+
+namespace EQSettings
+{
+    Bands getDefaults()
+    {
+        Bands bands;
+        for (int i = 0; i < Constants::defaultNumBands; ++i)
+            bands.push_back(EQProcessor::getDefaultBand(i));
+
+        return bands;
+    }
+
+    juce::Result load(const juce::File& file, Bands& bands)
+    {
+        if (!file.existsAsFile())
+            return juce::Result::fail("Settings file not found: " + file.getFullPathName());
+
+        juce::var json;
+        auto parseResult = juce::JSON::parse(file.loadFileAsString(), json);
+        if (parseResult.failed())
+            return juce::Result::fail(file.getFileName() + ": " + parseResult.getErrorMessage());
+
+        auto* list = json["bands"].getArray();
+        if (list == nullptr)
+            return juce::Result::fail(file.getFileName() + ": missing \"bands\" array");
+
+        if (list->isEmpty() || list->size() > Constants::maxBands)
+            return juce::Result::fail(file.getFileName() + ": expected 1 to " + juce::String(Constants::maxBands) + " bands");
+
+        Bands loaded;
+
+        for (int i = 0; i < list->size(); ++i)
+        {
+            const auto& band = list->getReference(i);
+            auto params = EQProcessor::getDefaultBand(i);
+
+            if (band.hasProperty("type"))
+            {
+                const auto typeName = band["type"].toString();
+                const auto* found = std::find(std::begin(typeNames), std::end(typeNames), typeName);
+                if (found == std::end(typeNames))
+                    return juce::Result::fail(file.getFileName() + ": unknown band type \"" + typeName + "\"");
+
+                params.type = static_cast<EQProcessor::FilterType>(std::distance(std::begin(typeNames), found));
+            }
+
+            if (band.hasProperty("frequency"))
+                params.freq = juce::jlimit((float)Constants::minFreq, (float)Constants::maxFreq, (float)band["frequency"]);
+
+            // Only peaks have a gain
+            if (band.hasProperty("gain") && params.type == CoefficientDesigner::Peak)
+                params.gainDb = juce::jlimit(Constants::minDb, Constants::maxDb, (float)band["gain"]);
+            else if (params.type != CoefficientDesigner::Peak)
+                params.gainDb = 0.0f;
+
+            if (band.hasProperty("q"))
+                params.Q = juce::jlimit(Constants::minQ, Constants::maxQ, (float)band["q"]);
+
+            if (band.hasProperty("enabled"))
+                params.enabled = (bool)band["enabled"];
+
+            loaded.push_back(params);
+        }
+
+        bands = loaded;
+        return juce::Result::ok();
+    }
+
+    juce::Result save(const juce::File& file, const Bands& bands)
+    {
+        juce::Array<juce::var> list;
+
+        for (const auto& params : bands)
+        {
+            auto* band = new juce::DynamicObject();
+            band->setProperty("type", typeNames[params.type]);
+            band->setProperty("frequency", params.freq);
+            band->setProperty("gain", params.gainDb);
+            band->setProperty("q", params.Q);
+            band->setProperty("enabled", params.enabled);
+            list.add(juce::var(band));
+        }
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("bands", list);
+
+        if (!file.replaceWithText(juce::JSON::toString(juce::var(root))))
+            return juce::Result::fail("Could not write " + file.getFullPathName());
+
+        return juce::Result::ok();
+    }
+
+    void apply(const Bands& bands, EQParameters& parameters, double morphSeconds)
+    {
+        jassert(!bands.empty() && bands.size() <= (size_t)Constants::maxBands);
+
+        auto curve = EQProcessor::getDefaultCurve();
+        curve.numBands = juce::jlimit(1, Constants::maxBands, static_cast<int>(bands.size()));
+        for (int i = 0; i < curve.numBands && i < static_cast<int>(bands.size()); ++i)
+            curve.bands[i] = bands[(size_t)i];
+
+        parameters.setCurve(curve, morphSeconds);
+    }
+}
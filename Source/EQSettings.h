@@ -0,0 +1,35 @@
+/*
+  ==============================================================================
+
+    EQSettings.h
+    Created: 16 Oct 2026 1:41:05pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Constants.h"
+#include "EQParameters.h"
+
+// Band settings stored as JSON, shared by the command-line modes:
+//
+//  { "bands": [ { "type": "highpass", "frequency": 33.0, "gain": 0.0, "q": 0.707, "enabled": true }, ... ] }
+//
+// One entry per band, 1 .. Constants::maxBands of them; "type" is "highpass", "peak" or "lowpass".
+// Missing fields keep the defaults of that band (EQProcessor::getDefaultBand).
+namespace EQSettings
+{
+    using Bands = std::vector<EQProcessor::BandParameters>;
+
+    Bands getDefaults();
+
+    juce::Result load(const juce::File& file, Bands& bands);
+    juce::Result save(const juce::File& file, const Bands& bands);
+
+    // Replaces the band count and every band in one edit (from the parameters' thread),
+    // optionally morphing there on the audio thread
+    void apply(const Bands& bands, EQParameters& parameters, double morphSeconds = 0.0);
+}
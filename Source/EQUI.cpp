@@ -11,37 +11,73 @@
 #include "EQUI.h"
 #include "Constants.h"
 
-EQUI::EQUI(EQProcessor& processor)
-    : eq(processor)
+EQUI::EQUI(EQProcessor& processor, EQParameters& parameterStore, SpectrumAnalyzer& spectrumAnalyzer)
+    : eq(processor), parameters(parameterStore), analyzer(spectrumAnalyzer)
 {
-    startTimerHz(30); // refresh at 30 fps
+    startTimerHz(60); // polls for new spectra, parameter edits and sample rate changes, painting is driven by state changes
     configureEQNodes();
-    magnitudes.resize(512); // points across the frequency range
+    configurePresets();
+    configureOversampling();
+    configureTracing();
+    addAndMakeVisible(spectrogram);
 }
 
 void EQUI::timerCallback()
 {
-    repaint(); // trigger paint at regular intervals
+    eq.syncSampleRate(); // pick up device sample rate changes on the message thread
+
+    // Edits made elsewhere, such as a preset recall
+    if (parameters.getVersion() != syncedVersion)
+        refreshFromParameters();
+
+    updateResponseCurve(); // repaints the curve only if the rate change moved it
+    updateSpectrum();
+
+    // Load figures are smoothed anyway, twice a second is plenty
+    if (--oversamplingInfoCountdown <= 0)
+    {
+        oversamplingInfoCountdown = 30;
+        updateOversamplingInfo();
+    }
 }
 
 void EQUI::paint(juce::Graphics& g)
 {
+    EQ_TRACE_SCOPE("EQUI::paint");
+
+    // Grid, ticks and labels come from the cached image
+    g.drawImage(backgroundImage, getLocalBounds().toFloat());
+
     auto bounds = getGraphBounds();
-    drawSetup(g, bounds);
-    drawFrequencyResponse(g, bounds);
+    drawSpectrum(g, bounds);
+    drawFrequencyResponse(g);
 }
 
 void EQUI::resized()
 {
+    renderBackground();
+    glyphCache.setScale(juce::Component::getApproximateScaleFactorForComponent(this));
+    analyzer.setNumPoints(getGraphBounds().getWidth()); // one spectrum point per pixel
+    spectrogram.setBounds(getSpectrogramBounds());
+    layOutHeader();
+
+    auto graphBounds = getGraphBounds();
+    if (performanceOverlay != nullptr)
+        performanceOverlay->setBounds(graphBounds.getX() + 8, graphBounds.getY() + 8, juce::jmin(380, graphBounds.getWidth() - 16), 120);
+
     // Graph node positions
     auto graphArea = getGraphBounds();
-    for (auto& band : eqNodes)
+    for (auto& node : eqNodes)
     {
-        band.position = {
-            freqToX(band.freq, graphArea),
-            gainToY(band.gain, graphArea)
+        const auto& params = parameters.getBand(node.bandIndex);
+        node.position = {
+            freqToX(params.freq, graphArea),
+            gainToY(params.gainDb, graphArea)
         };
     }
+
+    updateResponseCurve();
+
     auto bounds = getLocalBounds();
     int columnWidth = static_cast<int>(bounds.getWidth() * 0.28f);
     auto sliderArea = bounds.removeFromRight(columnWidth);
@@ -56,22 +92,26 @@ void EQUI::resized()
     const int h = 30;
     const int spacing = 8;
 
-    for (auto& band : eqNodes)
-    {
-        band.freqSlider.setBounds(x, y, sliderArea.getWidth(), h);
-        y += h + spacing;
+    presetAButton.setBounds(x, y, h, h);
+    presetBButton.setBounds(x + h, y, h, h);
+    morphTimeSlider.setBounds(x + 2 * h + spacing, y, sliderArea.getWidth() - 2 * h - spacing, h);
+    y += h + spacing * 2;
 
-        if (band.bandIndex >= EQProcessor::Peak1 && band.bandIndex <= EQProcessor::Peak4)
-        {
-            band.gainSlider.setBounds(x, y, sliderArea.getWidth(), h);
-            y += h + spacing;
-        }
+    bandCountSlider.setBounds(x, y, sliderArea.getWidth(), h);
+    y += h + spacing * 4;
 
-        band.qSlider.setBounds(x, y, sliderArea.getWidth(), h);
-        y += h + spacing * 2;
-    }
+    selectedBandLabel.setBounds(x, y, sliderArea.getWidth(), h);
+    y += h + spacing;
+
+    bandTypeBox.setBounds(x, y, sliderArea.getWidth() / 2 - spacing, h);
+    bandEnabledButton.setBounds(x + sliderArea.getWidth() / 2, y, sliderArea.getWidth() / 2, h);
+    y += h + spacing;
 
-    
+    for (auto* slider : { &freqSlider, &gainSlider, &qSlider })
+    {
+        slider->setBounds(x, y, sliderArea.getWidth(), h);
+        y += h + spacing;
+    }
 }
 
 
@@ -83,9 +123,58 @@ juce::Rectangle<int> EQUI::getGraphBounds() const
     auto bounds = getLocalBounds();
     int sliderColumnWidth = static_cast<int>(bounds.getWidth() * 0.28f); // match layout %
     bounds.removeFromRight(sliderColumnWidth);
+    bounds.removeFromBottom(bounds.getHeight() / 4); // spectrogram strip
     return bounds.reduced(50, 50); // match visual margin
 }
 
+void EQUI::layOutHeader()
+{
+    // One row above the graph and the slider column. Items shrink rather than overlap when it gets narrow.
+    juce::FlexBox header;
+    auto add = [&header](juce::Component& control, int width)
+    {
+        header.items.add(juce::FlexItem(control).withWidth(static_cast<float>(width)).withMargin({ 0, 8, 0, 0 }));
+    };
+
+    for (auto& [control, width] : headerControls)
+        add(*control, width);
+
+    if (timingButton.isVisible())
+        add(timingButton, 80);
+
+    add(traceButton, 90);
+
+    // Processing mode at the right end
+    header.items.add(juce::FlexItem().withFlexGrow(1.0f));
+    add(linearPhaseButton, 150);
+    add(oversamplingBox, 110);
+    header.items.add(juce::FlexItem(oversamplingInfo).withWidth(185.0f));
+
+    header.performLayout(getLocalBounds().reduced(10, 0).withY(12).withHeight(24));
+}
+
+juce::Rectangle<int> EQUI::getSpectrogramBounds() const
+{
+    // Under the graph's axis labels, same x range as the graph so frequencies line up
+    auto graph = getGraphBounds();
+    auto bounds = getLocalBounds();
+    return { graph.getX(), graph.getBottom() + 50, graph.getWidth(), juce::jmax(0, bounds.getBottom() - 20 - (graph.getBottom() + 50)) };
+}
+
+void EQUI::renderBackground()
+{
+    // Rendered at the display scale so it stays sharp on high-DPI screens
+    const auto scale = juce::Component::getApproximateScaleFactorForComponent(this);
+    const int width = juce::jmax(1, juce::roundToInt(getWidth() * scale));
+    const int height = juce::jmax(1, juce::roundToInt(getHeight() * scale));
+
+    backgroundImage = juce::Image(juce::Image::RGB, width, height, false);
+
+    juce::Graphics g(backgroundImage);
+    g.addTransform(juce::AffineTransform::scale(scale));
+    drawSetup(g, getGraphBounds());
+}
+
 void EQUI::drawSetup(juce::Graphics& g, juce::Rectangle<int> bounds)
 {
     // Make background black
@@ -144,156 +233,181 @@ void EQUI::drawSetup(juce::Graphics& g, juce::Rectangle<int> bounds)
 
 }
 
-void EQUI::drawFrequencyResponse(juce::Graphics& g, juce::Rectangle<int> bounds)
+void EQUI::drawSpectrum(juce::Graphics& g, juce::Rectangle<int> bounds)
 {
-    const int width = bounds.getWidth();
+    EQ_TRACE_SCOPE("EQUI::drawSpectrum");
 
-    juce::Path responsePath;
+    if (!g.clipRegionIntersects(bounds))
+        return;
 
-    // Get decibel values
-    for (int i = 0; i < magnitudes.size(); ++i)
+    const juce::Colour colours[SpectrumAnalyzer::numTaps] = {
+        juce::Colours::white.withAlpha(0.12f),            // pre EQ
+        juce::Colour::fromRGB(0, 170, 255).withAlpha(0.35f) // post EQ
+    };
+
+    for (int tap = 0; tap < SpectrumAnalyzer::numTaps; ++tap)
     {
-        double freq = Constants::minFreq * std::pow(Constants::maxFreq / Constants::minFreq, (double)i / (magnitudes.size() - 1));
-        auto magnitude = eq.getMagnitudeForFrequency(freq, eq.getSampleRate());
-        magnitudes[i] = juce::Decibels::gainToDecibels(magnitude);
+        g.setColour(colours[tap]);
+        g.fillPath(spectrumPaths[tap]);
+
+        g.setColour(colours[tap].withMultipliedAlpha(2.0f));
+        g.strokePath(peakPaths[tap], juce::PathStrokeType(1.0f));
     }
+}
 
-    // Fetch from magnitude
-    for (int i = 0; i < magnitudes.size(); ++i)
+void EQUI::drawFrequencyResponse(juce::Graphics& g)
+{
+    EQ_TRACE_SCOPE("EQUI::drawFrequencyResponse");
+
+    // The path is rebuilt by updateResponseCurve(), never here
+    if (g.clipRegionIntersects(getCurveArea()))
     {
-        double freq = Constants::minFreq * std::pow(Constants::maxFreq / Constants::minFreq, (double)i / (magnitudes.size() - 1));
-        int x = freqToX(freq, bounds);
-        float dB = juce::jlimit(Constants::minDb, Constants::maxDb, (float)magnitudes[i]);
-        float y = juce::jmap(dB, Constants::minDb, Constants::maxDb, (float)(bounds.getBottom()), (float)(bounds.getY()));
+        g.setColour(juce::Colours::white);
+        g.strokePath(responsePath, juce::PathStrokeType(2.0f));
+    }
+
+    // Draw nodes
+    drawNodes(g);
+}
+
+void EQUI::drawNodes(juce::Graphics& g)
+{
+    for (int i = 0; i < (int)eqNodes.size(); i++)
+    {
+        auto& node = eqNodes[i];
+        const auto& params = parameters.getBand(i);
+
+        // Skip nodes outside the invalidated region
+        if (!g.clipRegionIntersects(getNodeArea(i)))
+            continue;
+
+        // One blit per node, the glyph is rendered once per band/hover/Q bucket. Bypassed bands are faded.
+        const auto& glyph = glyphCache.getGlyph(i, nodeUnderMouse == i || selectedBand == i, params.Q);
+        g.setOpacity(params.enabled ? 1.0f : 0.35f);
+        g.drawImage(glyph, juce::Rectangle<float>(NodeGlyphCache::glyphSize, NodeGlyphCache::glyphSize).withCentre(node.position));
+    }
+}
+
+
+// Invalidation
+void EQUI::updateResponseCurve()
+{
+    auto bounds = getGraphBounds();
+
+    if (!response.update(eq) && bounds == responsePathBounds)
+        return;
+
+    const auto oldArea = getCurveArea();
+
+    responsePath.clear();
+    responsePathBounds = bounds;
+
+    const float* curveDb = response.getCurveDb();
+
+    for (int i = 0; i < response.getNumPoints(); ++i)
+    {
+        float x = bounds.getX() + response.getNormalisedX(i) * bounds.getWidth();
+        float dB = juce::jlimit(Constants::minDb, Constants::maxDb, curveDb[i]);
+        float y = gainToY(dB, bounds);
 
         if (i == 0)
-            responsePath.startNewSubPath((float)x, y);
+            responsePath.startNewSubPath(x, y);
         else
-            responsePath.lineTo((float)x, y);
+            responsePath.lineTo(x, y);
     }
 
-    g.setColour(juce::Colours::white);
-    g.strokePath(responsePath, juce::PathStrokeType(2.0f));
-
-    // Draw nodes
-    drawNodes(g, bounds);
+    repaint(oldArea.getUnion(getCurveArea()));
 }
 
-void EQUI::drawNodes(juce::Graphics& g, juce::Rectangle<int> bounds)
+void EQUI::updateSpectrum()
 {
-    // Draw bands 1 through 6
-    for (int i = 0; i < eqNodes.size(); i++)
+    auto bounds = getGraphBounds();
+    bool changed = false;
+
+    auto toY = [&](float dB)
     {
-        auto& node = eqNodes[i];
-        node.position = { freqToX(node.freq, bounds), gainToY(node.gain, bounds) };
+        return juce::jmap(juce::jlimit(Constants::analyzerMinDb, Constants::analyzerMaxDb, dB),
+            Constants::analyzerMinDb, Constants::analyzerMaxDb,
+            static_cast<float>(bounds.getBottom()), static_cast<float>(bounds.getY()));
+    };
 
-        // fill ellipse with transparent background of appropriate colour
-        float alpha = (nodeUnderMouse == i) ? 0.4f : 0.2f;
-        g.setColour(Constants::bandColours[i].withAlpha(alpha));
-        g.fillEllipse(node.position.x - 12, node.position.y - 12, 24, 24);
+    for (int tap = 0; tap < SpectrumAnalyzer::numTaps; ++tap)
+    {
+        if (!analyzer.pullSpectrum(static_cast<SpectrumAnalyzer::Tap>(tap)))
+            continue;
 
-        // black outline
-        g.setColour(juce::Colours::black);
-        g.drawEllipse(node.position.x - 12, node.position.y - 12, 24, 24, 2);
+        const auto& spectrum = analyzer.getSpectrum(static_cast<SpectrumAnalyzer::Tap>(tap));
+        const int numPoints = static_cast<int>(spectrum.levelDb.size());
 
-        g.setColour(juce::Colours::white);
-        g.setFont(20.0f);
+        auto& fill = spectrumPaths[tap];
+        auto& peaks = peakPaths[tap];
+        fill.clear();
+        peaks.clear();
+        changed = true;
 
-        juce::String label = juce::String(i + 1);
+        // Published before a resize caught up, the next one will fit
+        if (numPoints < 2)
+            continue;
 
-        // First, draw black outline around the text by offsetting it in all directions
-        g.setColour(juce::Colours::black);
-        for (int dx = -1; dx <= 1; ++dx)
+        // Points are evenly spaced in log frequency across the graph
+        auto toX = [&](int i) { return bounds.getX() + bounds.getWidth() * static_cast<float>(i) / (numPoints - 1); };
+
+        fill.startNewSubPath(toX(0), static_cast<float>(bounds.getBottom()));
+        for (int i = 0; i < numPoints; ++i)
         {
-            for (int dy = -1; dy <= 1; ++dy)
-            {
-                if (dx != 0 || dy != 0)
-                {
-                    g.drawText(label,
-                        node.position.x - 12 + dx,
-                        node.position.y - 12 + dy,
-                        24, 24,
-                        juce::Justification::centred, false);
-                }
-            }
-        }
+            fill.lineTo(toX(i), toY(spectrum.levelDb[(size_t)i]));
 
-        // Then draw the number of the band (index + 1)
-        g.setColour(Constants::bandColours[i].interpolatedWith(juce::Colours::white, 0.75f));
-        g.drawText(label,
-            node.position.x - 12, node.position.y - 12, 24, 24,
-            juce::Justification::centred, false);
-
-        // Add some rings to the outside
-        float qNorm = juce::jmap(node.Q, Constants::minQ, Constants::maxQ, 0.0f, 1.0f);
-        float arcSpanRadians = juce::jmap(
-            qNorm,
-            0.0f,
-            1.0f,
-            0.0f,
-            juce::MathConstants<float>::halfPi); // 0 to 90 degrees (in rads)
-
-        float radius = 12.0f;
-        juce::Path upperLeftArc;
-        juce::Path upperRightArc;
-        juce::Path lowerLeftArc;
-        juce::Path lowerRightArc;
-
-        upperLeftArc.addCentredArc(
-            node.position.x, node.position.y,
-            radius, radius,
-            0.0f,
-            0.0f,
-            -1 * arcSpanRadians,
-            true
-        );
-
-        upperRightArc.addCentredArc(
-            node.position.x, node.position.y,
-            radius, radius,
-            0.0f,
-            0.0f,
-            arcSpanRadians,
-            true
-        );
-
-        lowerLeftArc.addCentredArc(
-            node.position.x, node.position.y,
-            radius, radius,
-            0.0f,
-            juce::MathConstants<float>::pi,
-            juce::MathConstants<float>::pi + arcSpanRadians,
-            true
-        );
-
-        lowerRightArc.addCentredArc(
-            node.position.x, node.position.y,
-            radius, radius,
-            0.0f,
-            juce::MathConstants<float>::pi,
-            juce::MathConstants<float>::pi - arcSpanRadians,
-            true
-        );
-
-        g.setColour(Constants::bandColours[i]);
-        g.strokePath(upperLeftArc, juce::PathStrokeType(2.0f));
-        g.strokePath(upperRightArc, juce::PathStrokeType(2.0f));
-        g.strokePath(lowerLeftArc, juce::PathStrokeType(2.0f));
-        g.strokePath(lowerRightArc, juce::PathStrokeType(2.0f));
-
-        // Finally, add some contour to the rings
-        float contourRadius = 14.0f;
-        float contourThickness = 2.0f;
-
-        g.setColour(juce::Colours::black);
-        g.drawEllipse(node.position.x - contourRadius,
-            node.position.y - contourRadius,
-            contourRadius * 2.0f,
-            contourRadius * 2.0f,
-            contourThickness);
+            if (i == 0)
+                peaks.startNewSubPath(toX(i), toY(spectrum.peakDb[(size_t)i]));
+            else
+                peaks.lineTo(toX(i), toY(spectrum.peakDb[(size_t)i]));
+        }
+        fill.lineTo(toX(numPoints - 1), static_cast<float>(bounds.getBottom()));
+        fill.closeSubPath();
     }
+
+    if (changed)
+        repaint(bounds);
+
+    // One row per frame whether or not a new spectrum arrived, so the time axis stays linear
+    spectrogram.addRow(analyzer.getSpectrum(SpectrumAnalyzer::PreEQ).levelDb);
 }
 
+void EQUI::updateNodePosition(int bandIndex)
+{
+    auto& node = eqNodes[bandIndex];
+    const auto& params = parameters.getBand(bandIndex);
+    auto bounds = getGraphBounds();
+    juce::Point<float> newPosition{ freqToX(params.freq, bounds), gainToY(params.gainDb, bounds) };
+
+    // Q changes redraw the rings even if the node did not move
+    repaint(getNodeArea(bandIndex));
+    node.position = newPosition;
+    repaint(getNodeArea(bandIndex));
+}
+
+juce::Rectangle<int> EQUI::getCurveArea() const
+{
+    // Include the stroke width
+    return responsePath.getBounds().expanded(2.0f).getSmallestIntegerContainer();
+}
+
+juce::Rectangle<int> EQUI::getNodeArea(int bandIndex) const
+{
+    return juce::Rectangle<float>(NodeGlyphCache::glyphSize, NodeGlyphCache::glyphSize)
+        .withCentre(eqNodes[bandIndex].position)
+        .getSmallestIntegerContainer();
+}
+
+int EQUI::getNodeAt(juce::Point<float> position) const
+{
+    // Last drawn is on top
+    for (int i = (int)eqNodes.size() - 1; i >= 0; --i)
+        if (eqNodes[i].position.getDistanceFrom(position) < 10.0f)
+            return i;
+
+    return -1;
+}
 
 // Position to DSP sync
 float EQUI::freqToX(float freq, juce::Rectangle<int> bounds) const
@@ -339,120 +453,382 @@ void EQUI::configureEQSlider(juce::Slider& slider, double min, double max, doubl
 
 void EQUI::configureEQNodes()
 {
-    // Set up nodes
-    for (int i = 0; i < eqNodes.size(); ++i)
+    bandCountSlider.setSliderStyle(juce::Slider::IncDecButtons);
+    bandCountSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 60, 20);
+    bandCountSlider.setRange(1.0, Constants::maxBands, 1.0);
+    bandCountSlider.setTextValueSuffix(" bands");
+    bandCountSlider.setValue(parameters.getNumBands(), juce::dontSendNotification);
+    bandCountSlider.onValueChange = [this]()
     {
-        auto& controls = eqNodes[i];
-        controls.bandIndex = i;
-        bool isPeak = (i >= EQProcessor::Peak1 && i <= EQProcessor::Peak4);
-
-        configureEQSlider(controls.freqSlider, Constants::minFreq, Constants::maxFreq, 1.0, " Hz", Constants::defaultFrequencies[i]);
-        controls.freq = controls.freqSlider.getValue();
-        configureEQSlider(controls.qSlider, Constants::minQ, Constants::maxQ, 0.1, "", Constants::defaultQs[i]);
-        controls.Q = controls.qSlider.getValue();
+        parameters.setNumBands(static_cast<int>(bandCountSlider.getValue()));
+        refreshFromParameters();
+    };
+    addAndMakeVisible(bandCountSlider);
+
+    addAndMakeVisible(selectedBandLabel);
+
+    // Item id is FilterType + 1
+    bandTypeBox.addItem("High-pass", CoefficientDesigner::HighPass + 1);
+    bandTypeBox.addItem("Peak", CoefficientDesigner::Peak + 1);
+    bandTypeBox.addItem("Low-pass", CoefficientDesigner::LowPass + 1);
+    bandTypeBox.onChange = [this]()
+    {
+        const auto type = static_cast<EQProcessor::FilterType>(bandTypeBox.getSelectedId() - 1);
+        parameters.setBandType(selectedBand, type);
 
-        // High-pass and Low-pass should not have a gain slider, only peaking
-        if (isPeak)
+        // High-pass and Low-pass have no gain, only peaking
+        if (type != CoefficientDesigner::Peak)
         {
-            configureEQSlider(controls.gainSlider, Constants::minDb, Constants::maxDb, 0.1, " dB", Constants::defaultGain);
-            controls.gain = controls.gainSlider.getValue();
+            const auto& params = parameters.getBand(selectedBand);
+            parameters.setBand(selectedBand, params.freq, 0.0f, params.Q);
         }
 
-        // Callback functions
-        controls.freqSlider.onValueChange = [this, i]() { handleSliderChange(i); };
-        controls.qSlider.onValueChange = [this, i]() { handleSliderChange(i); };
-        if (isPeak)
-            controls.gainSlider.onValueChange = [this, i]() { handleSliderChange(i); };
-            
+        handleNodeChange(selectedBand);
+        selectBand(selectedBand);
+    };
+    addAndMakeVisible(bandTypeBox);
+
+    bandEnabledButton.setTooltip("Bypassed bands cost no DSP (double-click a node to toggle)");
+    bandEnabledButton.onClick = [this]()
+    {
+        parameters.setBandEnabled(selectedBand, bandEnabledButton.getToggleState());
+        handleNodeChange(selectedBand);
+    };
+    addAndMakeVisible(bandEnabledButton);
+
+    configureEQSlider(freqSlider, Constants::minFreq, Constants::maxFreq, 1.0, " Hz", Constants::defaultFrequencies[0]);
+    configureEQSlider(gainSlider, Constants::minDb, Constants::maxDb, 0.1, " dB", Constants::defaultGain);
+    configureEQSlider(qSlider, Constants::minQ, Constants::maxQ, 0.1, "", Constants::defaultQs[0]);
+
+    // Callback functions
+    freqSlider.onValueChange = [this]() { handleSliderChange(); };
+    gainSlider.onValueChange = [this]() { handleSliderChange(); };
+    qSlider.onValueChange = [this]() { handleSliderChange(); };
+
+    syncNodes();
+}
+
+void EQUI::configurePresets()
+{
+    const std::pair<juce::TextButton*, EQParameters::Slot> buttons[] = { { &presetAButton, EQParameters::A },
+                                                                         { &presetBButton, EQParameters::B } };
+    for (auto [button, slot] : buttons)
+    {
+        button->setClickingTogglesState(true);
+        button->setRadioGroupId(1);
+        button->setToggleState(parameters.getActivePreset() == slot, juce::dontSendNotification);
+        button->setTooltip("Edits go to the active preset. Switching morphs to the other one over the morph time");
+        button->onClick = [this, button = button, slot = slot]()
+        {
+            if (!button->getToggleState())
+                return;
+
+            parameters.switchToPreset(slot, morphTimeSlider.getValue());
+            refreshFromParameters();
+        };
+        addAndMakeVisible(*button);
+    }
+
+    morphTimeSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    morphTimeSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 60, 20);
+    morphTimeSlider.setRange(0.0, 10.0, 0.01);
+    morphTimeSlider.setSkewFactorFromMidPoint(1.0);
+    morphTimeSlider.setTextValueSuffix(" s");
+    morphTimeSlider.setTooltip("Morph time between presets, 0 switches at once");
+    morphTimeSlider.setValue(0.0);
+
+    // The host's parameters drive the curve and jump to the recalled preset, so a morph would never be heard
+    if (eq.isCurveFromAutomation())
+    {
+        presetAButton.setTooltip("Edits go to the active preset");
+        presetBButton.setTooltip("Edits go to the active preset");
+        return;
     }
+
+    addAndMakeVisible(morphTimeSlider);
 }
 
-void EQUI::handleSliderChange(int bandIndex)
+void EQUI::syncNodes()
 {
-    auto& c = eqNodes[bandIndex];
+    // The parameters own the bands; nodes are a view of them
+    syncedVersion = parameters.getVersion();
+    eqNodes.resize((size_t)parameters.getNumBands());
+
+    auto bounds = getGraphBounds();
+    for (int i = 0; i < (int)eqNodes.size(); ++i)
+    {
+        const auto& params = parameters.getBand(i);
+        auto& node = eqNodes[i];
+        node.bandIndex = i;
+        node.position = { freqToX(params.freq, bounds), gainToY(params.gainDb, bounds) };
+    }
+
+    bandCountSlider.setValue(parameters.getNumBands(), juce::dontSendNotification);
+    presetAButton.setToggleState(parameters.getActivePreset() == EQParameters::A, juce::dontSendNotification);
+    presetBButton.setToggleState(parameters.getActivePreset() == EQParameters::B, juce::dontSendNotification);
 
-    c.freq = c.freqSlider.getValue();
-    c.Q = c.qSlider.getValue();
-    c.gain = (bandIndex >= EQProcessor::Peak1 && bandIndex <= EQProcessor::Peak4)
-        ? c.gainSlider.getValue()
-        : 0.0f;
+    selectBand(juce::jmin(selectedBand, (int)eqNodes.size() - 1));
+}
+
+void EQUI::refreshFromParameters()
+{
+    // Any band may have moved or gone
+    if (nodeUnderMouse >= parameters.getNumBands())
+        nodeUnderMouse = -1;
+    if (nodeBeingDragged >= parameters.getNumBands())
+        nodeBeingDragged = -1;
+
+    syncNodes();
+
+    repaint(getGraphBounds().expanded(NodeGlyphCache::glyphSize));
+    updateResponseCurve();
+}
 
-    eq.updateEQ(bandIndex, c.freq, c.gain, c.Q);
+void EQUI::selectBand(int bandIndex)
+{
+    if (selectedBand >= 0 && selectedBand < (int)eqNodes.size())
+        repaint(getNodeArea(selectedBand));
+
+    selectedBand = bandIndex;
+    const auto& params = parameters.getBand(selectedBand);
+
+    // Sync controls (without triggering callbacks)
+    selectedBandLabel.setText("Band " + juce::String(bandIndex + 1), juce::dontSendNotification);
+    selectedBandLabel.setColour(juce::Label::textColourId, Constants::getBandColour(bandIndex));
+    bandTypeBox.setSelectedId(params.type + 1, juce::dontSendNotification);
+    bandEnabledButton.setToggleState(params.enabled, juce::dontSendNotification);
+    freqSlider.setValue(params.freq, juce::dontSendNotification);
+    gainSlider.setValue(params.gainDb, juce::dontSendNotification);
+    qSlider.setValue(params.Q, juce::dontSendNotification);
+    gainSlider.setEnabled(params.type == CoefficientDesigner::Peak);
+
+    repaint(getNodeArea(selectedBand));
+}
+
+void EQUI::setPerformanceMonitor(PerformanceMonitor& monitor)
+{
+    performanceOverlay = std::make_unique<PerformanceOverlay>(monitor);
+    addChildComponent(*performanceOverlay);
+
+    timingButton.setTooltip("Audio callback timing against the block period. Click the overlay to reset it.");
+    timingButton.onClick = [this]() { performanceOverlay->setVisible(timingButton.getToggleState()); };
+    addAndMakeVisible(timingButton);
+
+    resized();
+}
+
+void EQUI::addHeaderControl(juce::Component& control, int width)
+{
+    headerControls.push_back({ &control, width });
+    addAndMakeVisible(control);
+
+    resized();
+}
+
+void EQUI::configureTracing()
+{
+    traceButton.setTooltip("Writes what the audio and UI threads did over the last seconds, for chrome://tracing or ui.perfetto.dev");
+    traceButton.setEnabled(EQ_TRACING != 0);
+    traceButton.onClick = [this]() { saveTrace(); };
+    addAndMakeVisible(traceButton);
+}
+
+void EQUI::saveTrace()
+{
+    // Taken now, before the file dialog adds its own events
+    const auto capture = juce::File::createTempFile(".json");
+    const auto result = TraceRecorder::getInstance().writeTrace(capture);
+    if (result.failed())
+    {
+        juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Trace", result.getErrorMessage());
+        return;
+    }
+
+    traceChooser = std::make_unique<juce::FileChooser>("Save trace",
+        juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("eq-trace.json"), "*.json");
+
+    traceChooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles,
+        [capture](const juce::FileChooser& fc)
+        {
+            const auto file = fc.getResult();
+            if (file == juce::File() || !capture.moveFileTo(file))
+                capture.deleteFile();
+        });
+}
+
+void EQUI::configureOversampling()
+{
+    // Item id is order + 1
+    for (int order = 0; order <= EQProcessor::maxOversamplingOrder; ++order)
+        oversamplingBox.addItem(juce::String(1 << order) + "x", order + 1);
+
+    oversamplingBox.setSelectedId(eq.getOversamplingOrder() + 1, juce::dontSendNotification);
+    oversamplingBox.setTooltip("Oversampling: higher factors follow the drawn curve more closely near Nyquist, at a higher DSP load");
+    oversamplingBox.onChange = [this]()
+    {
+        eq.setOversamplingOrder(oversamplingBox.getSelectedId() - 1);
+        updateResponseCurve();
+    };
+    addAndMakeVisible(oversamplingBox);
+
+    // Oversampling does not apply to the FIR
+    linearPhaseButton.setToggleState(eq.isLinearPhase(), juce::dontSendNotification);
+    oversamplingBox.setEnabled(!eq.isLinearPhase());
+    linearPhaseButton.onClick = [this]()
+    {
+        eq.setLinearPhase(linearPhaseButton.getToggleState());
+        oversamplingBox.setEnabled(!eq.isLinearPhase());
+        updateResponseCurve();
+    };
+    addAndMakeVisible(linearPhaseButton);
+
+    oversamplingInfo.setJustificationType(juce::Justification::centredLeft);
+    addAndMakeVisible(oversamplingInfo);
+}
+
+void EQUI::updateOversamplingInfo()
+{
+    // A plugin host can switch these too
+    oversamplingBox.setSelectedId(eq.getOversamplingOrder() + 1, juce::dontSendNotification);
+    linearPhaseButton.setToggleState(eq.isLinearPhase(), juce::dontSendNotification);
+    oversamplingBox.setEnabled(!eq.isLinearPhase());
+
+    // Every factor shows the load it had when last active, so they can be compared
+    for (int order = 0; order <= EQProcessor::maxOversamplingOrder; ++order)
+    {
+        const double load = eq.getProcessingLoad(order);
+        juce::String text = juce::String(1 << order) + "x";
+        if (load > 0.0)
+            text << "  (" << juce::String(load * 100.0, 1) << "% DSP)";
+
+        oversamplingBox.changeItemText(order + 1, text);
+    }
+
+    const double linearPhaseLoad = eq.getLinearPhaseLoad();
+    linearPhaseButton.setButtonText(linearPhaseLoad > 0.0
+        ? "Linear phase (" + juce::String(linearPhaseLoad * 100.0, 1) + "% DSP)"
+        : juce::String("Linear phase"));
+
+    const double sampleRate = eq.getSampleRate();
+    const double latencyMs = sampleRate > 0.0 ? 1000.0 * eq.getLatencyInSamples() / sampleRate : 0.0;
+
+    oversamplingInfo.setText("Latency " + juce::String(eq.getLatencyInSamples(), 0) + " samples ("
+        + juce::String(latencyMs, 2) + " ms)", juce::dontSendNotification);
+}
+
+void EQUI::handleSliderChange()
+{
+    const bool isPeak = parameters.getBand(selectedBand).type == CoefficientDesigner::Peak;
+
+    parameters.setBand(selectedBand, static_cast<float>(freqSlider.getValue()),
+        isPeak ? static_cast<float>(gainSlider.getValue()) : 0.0f,
+        static_cast<float>(qSlider.getValue()));
+    syncedVersion = parameters.getVersion();
 
     // Adjust graphic nodes.
-    repaint();
+    updateNodePosition(selectedBand);
+    updateResponseCurve();
 }
 
 void EQUI::handleNodeChange(int bandIndex)
 {
-    auto& c = eqNodes[bandIndex];
-
-    // Update DSP
-    eq.updateEQ(c.bandIndex, c.freq, c.gain, c.Q);
+    // Our own edit, nothing to resync
+    syncedVersion = parameters.getVersion();
+    const auto& params = parameters.getBand(bandIndex);
 
     // Sync sliders (without triggering callbacks)
-    c.freqSlider.setValue(c.freq, juce::dontSendNotification);
-    c.qSlider.setValue(c.Q, juce::dontSendNotification);
-    if (c.bandIndex >= EQProcessor::Peak1 && c.bandIndex <= EQProcessor::Peak4)
-        c.gainSlider.setValue(c.gain, juce::dontSendNotification);
+    if (bandIndex == selectedBand)
+    {
+        freqSlider.setValue(params.freq, juce::dontSendNotification);
+        qSlider.setValue(params.Q, juce::dontSendNotification);
+        gainSlider.setValue(params.gainDb, juce::dontSendNotification);
+    }
 
     // Redraw curve and node position
-    repaint();
+    updateNodePosition(bandIndex);
+    updateResponseCurve();
 }
 
 
 // Mouse Events
 void EQUI::mouseDown(const juce::MouseEvent& e)
 {
-    for (size_t i = 0; i < eqNodes.size(); ++i)
-    {
-        if (eqNodes[i].position.getDistanceFrom(e.position) < 10.0f)
-        {
-            nodeBeingDragged = (int)i;
-            break;
-        }
-    }
+    EQ_TRACE_SCOPE("EQUI::mouseDown");
+
+    nodeBeingDragged = getNodeAt(e.position);
+
+    if (nodeBeingDragged >= 0)
+        selectBand(nodeBeingDragged);
 }
 
-void EQUI::mouseUp(const juce::MouseEvent&) { nodeBeingDragged = -1; }
+void EQUI::mouseDoubleClick(const juce::MouseEvent& e)
+{
+    EQ_TRACE_SCOPE("EQUI::mouseDoubleClick");
+
+    // Bypass or restore the band
+    const int bandIndex = getNodeAt(e.position);
+    if (bandIndex < 0)
+        return;
+
+    selectBand(bandIndex);
+    bandEnabledButton.setToggleState(!parameters.getBand(bandIndex).enabled, juce::sendNotificationSync);
+}
+
+void EQUI::mouseUp(const juce::MouseEvent&)
+{
+    EQ_TRACE_SCOPE("EQUI::mouseUp");
+
+    nodeBeingDragged = -1;
+}
 
 void EQUI::mouseMove(const juce::MouseEvent& e)
 {
-    nodeUnderMouse = -1;
-    for (size_t i = 0; i < eqNodes.size(); ++i)
-    {
-        if (eqNodes[i].position.getDistanceFrom(e.position) < 10.0f)
-        {
-            nodeUnderMouse = (int)i;
-            break;
-        }
-    }
-    repaint();
+    EQ_TRACE_SCOPE("EQUI::mouseMove");
+
+    const int newNodeUnderMouse = getNodeAt(e.position);
+    if (newNodeUnderMouse == nodeUnderMouse)
+        return;
+
+    // Only the highlight of the old and new node changes
+    if (nodeUnderMouse >= 0)
+        repaint(getNodeArea(nodeUnderMouse));
+
+    nodeUnderMouse = newNodeUnderMouse;
+
+    if (nodeUnderMouse >= 0)
+        repaint(getNodeArea(nodeUnderMouse));
 }
 
 void EQUI::mouseDrag(const juce::MouseEvent& e)
 {
+    EQ_TRACE_SCOPE("EQUI::mouseDrag");
+
     if (nodeBeingDragged < 0 || nodeBeingDragged >= (int)eqNodes.size())
         return;
 
-    auto& node = eqNodes[nodeBeingDragged];
+    const auto& params = parameters.getBand(nodeBeingDragged);
     auto bounds = getGraphBounds();
-    node.freq = juce::jlimit<float>(Constants::minFreq, Constants::maxFreq, xToFreq(e.position.x, bounds));
+    const float freq = juce::jlimit<float>(Constants::minFreq, Constants::maxFreq, xToFreq(e.position.x, bounds));
 
     // Only allow vertical dragging (gain) for peaking filters
-    if (node.bandIndex >= EQProcessor::Peak1 && node.bandIndex <= EQProcessor::Peak4)
-        node.gain = juce::jlimit(Constants::minDb, Constants::maxDb, yToGain(e.position.y, bounds));
-    
-    handleNodeChange(node.bandIndex);
+    const float gain = params.type == CoefficientDesigner::Peak
+        ? juce::jlimit(Constants::minDb, Constants::maxDb, yToGain(e.position.y, bounds))
+        : params.gainDb;
+
+    parameters.setBand(nodeBeingDragged, freq, gain, params.Q);
+    handleNodeChange(nodeBeingDragged);
 }
 
 void EQUI::mouseWheelMove(const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel)
 {
+    EQ_TRACE_SCOPE("EQUI::mouseWheelMove");
+
     if (nodeUnderMouse >= 0)
     {
-        auto& node = eqNodes[nodeUnderMouse];
-        node.Q = juce::jlimit(Constants::minQ, Constants::maxQ, node.Q + wheel.deltaY);
-        
-        handleNodeChange(node.bandIndex);
+        const auto& params = parameters.getBand(nodeUnderMouse);
+        parameters.setBand(nodeUnderMouse, params.freq, params.gainDb,
+            juce::jlimit(Constants::minQ, Constants::maxQ, params.Q + wheel.deltaY));
+
+        handleNodeChange(nodeUnderMouse);
     }
 }
\ No newline at end of file
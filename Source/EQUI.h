@@ -11,42 +11,100 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "EQParameters.h"
 #include "EQProcessor.h"
+#include "FrequencyResponse.h"
+#include "NodeGlyphCache.h"
+#include "PerformanceOverlay.h"
+#include "SpectrumAnalyzer.h"
+#include "SpectrogramView.h"
 
 class EQUI : public juce::Component,
     private juce::Timer
 {
     public:
-        EQUI(EQProcessor& processor);
+        EQUI(EQProcessor& processor, EQParameters& parameterStore, SpectrumAnalyzer& spectrumAnalyzer);
         ~EQUI() override = default;
 
         void paint(juce::Graphics& g) override;
         void resized() override;
 
-        // Structure for an individual node
+        // Structure for an individual node. Its settings live in EQParameters.
         struct EQNode
         {
             int bandIndex;
-            float freq;
-            float gain;
-            float Q;
-            juce::Slider freqSlider;
-            juce::Slider gainSlider;
-            juce::Slider qSlider;
             juce::Point<float> position;
         };
 
-        // array of 6 Band controls
-        std::array<EQNode, 6> eqNodes;
+        // One node per band, parameters.getNumBands() of them
+        std::vector<EQNode> eqNodes;
 
-        void handleSliderChange(int bandIndex);
+        void handleSliderChange();
         void handleNodeChange(int bandIndex);
 
+        // Adds a Timing button that shows the monitor's figures over the graph. The monitor must outlive this.
+        void setPerformanceMonitor(PerformanceMonitor& monitor);
+
+        // Puts an owner's control (e.g. a test tone toggle) at the start of the header row,
+        // so it shares the row's layout with the UI's own controls. The control must outlive this.
+        void addHeaderControl(juce::Component& control, int width);
+
     private:
         void timerCallback() override;
    
         EQProcessor& eq;
-        std::vector<double> magnitudes;
+        EQParameters& parameters;
+        SpectrumAnalyzer& analyzer;
+
+        // Last parameter version the nodes and controls show, anything newer was edited elsewhere
+        juce::uint32 syncedVersion = 0;
+
+        // Pre/post spectrum fills and their peak-hold lines, rebuilt when a new spectrum arrives
+        std::array<juce::Path, SpectrumAnalyzer::numTaps> spectrumPaths;
+        std::array<juce::Path, SpectrumAnalyzer::numTaps> peakPaths;
+
+        SpectrogramView spectrogram;
+
+        // Band count, and the controls of the selected band (click a node to select it)
+        juce::Slider bandCountSlider;
+        juce::Label selectedBandLabel;
+        juce::ComboBox bandTypeBox;
+        juce::ToggleButton bandEnabledButton{ "Enabled" };
+        juce::Slider freqSlider;
+        juce::Slider gainSlider;
+        juce::Slider qSlider;
+        int selectedBand = 0;
+
+        // A/B presets, switched instantly or morphed over the chosen time
+        juce::TextButton presetAButton{ "A" };
+        juce::TextButton presetBButton{ "B" };
+        juce::Slider morphTimeSlider;
+
+        // Oversampling factor or linear phase, with each mode's measured DSP load and the active latency
+        juce::ToggleButton linearPhaseButton{ "Linear phase" };
+        juce::ComboBox oversamplingBox;
+        juce::Label oversamplingInfo;
+        int oversamplingInfoCountdown = 0;
+
+        // Owner's controls at the start of the header row, with their widths
+        std::vector<std::pair<juce::Component*, int>> headerControls;
+
+        // Callback timing, only when an owner measures it
+        juce::ToggleButton timingButton{ "Timing" };
+        std::unique_ptr<PerformanceOverlay> performanceOverlay;
+
+        // Writes the last seconds of trace markers from every thread (see TraceRecorder)
+        juce::TextButton traceButton{ "Save trace" };
+        std::unique_ptr<juce::FileChooser> traceChooser;
+
+        // Cached curve, only re-evaluated for bands that changed
+        FrequencyResponse response{ 512 }; // points across the frequency range
+        juce::Path responsePath;
+        juce::Rectangle<int> responsePathBounds;
+
+        // Grid, ticks and labels, re-rendered only in resized()
+        juce::Image backgroundImage;
+        NodeGlyphCache glyphCache;
 
         int nodeUnderMouse = -1; // for highlighting
         int nodeBeingDragged = -1; // current Node
@@ -55,9 +113,21 @@ class EQUI : public juce::Component,
 
         // Drawing Code
         juce::Rectangle<int> getGraphBounds() const;
+        juce::Rectangle<int> getSpectrogramBounds() const;
+        void layOutHeader();
         void drawSetup(juce::Graphics& g, juce::Rectangle<int> bounds);
-        void drawFrequencyResponse(juce::Graphics& g, juce::Rectangle<int> bounds);
-        void drawNodes(juce::Graphics& g, juce::Rectangle<int> bounds);
+        void drawSpectrum(juce::Graphics& g, juce::Rectangle<int> bounds);
+        void drawFrequencyResponse(juce::Graphics& g);
+        void drawNodes(juce::Graphics& g);
+        void renderBackground();
+
+        // Invalidation: repaint only what moved
+        void updateResponseCurve();
+        void updateSpectrum();
+        void updateNodePosition(int bandIndex);
+        juce::Rectangle<int> getCurveArea() const;
+        juce::Rectangle<int> getNodeArea(int bandIndex) const;
+        int getNodeAt(juce::Point<float> position) const;
 
         // Position to DSP sync
         float freqToX(float freq, juce::Rectangle<int> bounds) const;
@@ -69,10 +139,19 @@ class EQUI : public juce::Component,
         void configureEQSlider(juce::Slider& slider, double min, double max, double step,
             const juce::String& suffix, double defaultValue);
         void configureEQNodes();
+        void configurePresets();
+        void syncNodes();
+        void refreshFromParameters();
+        void selectBand(int bandIndex);
+        void configureOversampling();
+        void configureTracing();
+        void saveTrace();
+        void updateOversamplingInfo();
 
         // Mouse Events
         void mouseDown(const juce::MouseEvent& event) override;
         void mouseDrag(const juce::MouseEvent& event) override;
+        void mouseDoubleClick(const juce::MouseEvent& event) override;
         void mouseUp(const juce::MouseEvent& event) override;
         void mouseMove(const juce::MouseEvent& event) override;
         void mouseWheelMove(const juce::MouseEvent& event, const juce::MouseWheelDetails& wheel) override;
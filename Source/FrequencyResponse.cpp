@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    FrequencyResponse.cpp
+    Created: 17 Oct 2026 9:48:30am
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "FrequencyResponse.h"
+
+namespace
+{
+    bool operator!=(const BiquadCoefficients& a, const BiquadCoefficients& b)
+    {
+        return a.b0 != b.b0 || a.b1 != b.b1 || a.b2 != b.b2 || a.a1 != b.a1 || a.a2 != b.a2;
+    }
+}
+
+FrequencyResponse::FrequencyResponse(int pointCount)
+    : numPoints(juce::jmax(2, pointCount)),
+      phi((size_t)numPoints), phiSquared((size_t)numPoints),
+      numerator((size_t)numPoints), denominator((size_t)numPoints),
+      curveDb((size_t)numPoints)
+{
+    for (auto& band : bandDb)
+        band.resize((size_t)numPoints);
+}
+
+bool FrequencyResponse::update(const EQProcessor& eq)
+{
+    // A new rate (or oversampling factor) moves every band
+    const double sampleRate = eq.getDesignSampleRate();
+    const bool gridChanged = sampleRate != gridSampleRate;
+    if (gridChanged)
+        computeGrid(sampleRate);
+
+    // Count and enable changes only rebuild the sum
+    bool changed = gridChanged;
+
+    if (eq.getNumBands() != numBands)
+    {
+        numBands = eq.getNumBands();
+        changed = true;
+    }
+
+    for (int i = 0; i < numBands; ++i)
+    {
+        // Bypassed bands drop out of the sum but keep their curve for when they come back
+        const bool active = eq.getBandParameters(i).enabled;
+        if (active != bandActive[i])
+        {
+            bandActive[i] = active;
+            changed = true;
+        }
+
+        // Only the bands that moved, or whose curve is from an older grid (e.g. outside the count back then)
+        const auto& coeffs = eq.getBandCoefficients(i);
+        if (bandGridRate[i] != gridSampleRate || coeffs != bandCoefficients[i])
+        {
+            computeBand(i, coeffs);
+            changed = true;
+        }
+    }
+
+    if (changed)
+    {
+        juce::FloatVectorOperations::clear(curveDb.data(), numPoints);
+        for (int i = 0; i < numBands; ++i)
+            if (bandActive[i])
+                juce::FloatVectorOperations::add(curveDb.data(), bandDb[i].data(), numPoints);
+    }
+
+    return changed;
+}
+
+void FrequencyResponse::computeGrid(double sampleRate)
+{
+    gridSampleRate = sampleRate;
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const double freq = Constants::minFreq * std::pow(Constants::maxFreq / Constants::minFreq, (double)i / (numPoints - 1));
+        const double s = std::sin(juce::MathConstants<double>::pi * freq / sampleRate);
+        phi[i] = static_cast<float>(s * s);
+        phiSquared[i] = static_cast<float>(s * s * s * s);
+    }
+}
+
+void FrequencyResponse::computeBand(int bandIndex, const BiquadCoefficients& c)
+{
+    bandCoefficients[bandIndex] = c;
+    bandGridRate[bandIndex] = gridSampleRate;
+
+    // |B|^2 = (b0 + b1 + b2)^2 - 4 (b0 b1 + b1 b2 + 4 b0 b2) phi + 16 b0 b2 phi^2, same for A with b0 = 1.
+    // Products are formed in double so that e.g. a high-pass numerator cancels to exactly zero.
+    const double b0 = c.b0, b1 = c.b1, b2 = c.b2, a1 = c.a1, a2 = c.a2;
+    auto evaluate = [this](std::vector<float>& dest, double x0, double x1, double x2)
+    {
+        const double p0 = (x0 + x1 + x2) * (x0 + x1 + x2);
+        const double p1 = -4.0 * (x0 * x1 + x1 * x2 + 4.0 * x0 * x2);
+        const double p2 = 16.0 * x0 * x2;
+
+        using FVO = juce::FloatVectorOperations;
+        FVO::copyWithMultiply(dest.data(), phiSquared.data(), static_cast<float>(p2), numPoints);
+        FVO::addWithMultiply(dest.data(), phi.data(), static_cast<float>(p1), numPoints);
+        FVO::add(dest.data(), static_cast<float>(p0), numPoints);
+    };
+
+    evaluate(numerator, b0, b1, b2);
+    evaluate(denominator, 1.0, a1, a2);
+
+    auto* dB = bandDb[bandIndex].data();
+    for (int i = 0; i < numPoints; ++i)
+        dB[i] = 10.0f * std::log10(juce::jmax(numerator[i], 1.0e-20f) / juce::jmax(denominator[i], 1.0e-20f));
+}
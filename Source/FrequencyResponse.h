@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    FrequencyResponse.h
+    Created: 17 Oct 2026 9:48:30am
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Constants.h"
+#include "EQProcessor.h"
+
+// EQ curve on a fixed log-frequency grid (minFreq..maxFreq), for drawing.
+// Each band keeps its own dB array, re-evaluated only when that band's
+// coefficients change; the total curve is the vectorised sum of the active bands.
+class FrequencyResponse
+{
+    public:
+        explicit FrequencyResponse(int numPoints = 512);
+
+        // Message thread. Returns true if the curve changed since the last call.
+        bool update(const EQProcessor& eq);
+
+        int getNumPoints() const { return numPoints; }
+        const float* getCurveDb() const { return curveDb.data(); }
+
+        // Points are evenly spaced in log frequency, so this maps straight to the x axis
+        float getNormalisedX(int pointIndex) const { return static_cast<float>(pointIndex) / static_cast<float>(numPoints - 1); }
+
+    private:
+        void computeGrid(double sampleRate);
+        void computeBand(int bandIndex, const BiquadCoefficients& coeffs);
+
+        const int numPoints;
+        double gridSampleRate = 0.0;
+
+        // phi = sin^2(w/2) and phi^2 per point, so a biquad's |H|^2 is two multiply-adds per point.
+        // This form avoids the cancellation that cos(w) suffers from at low frequencies.
+        std::vector<float> phi, phiSquared;
+        std::vector<float> numerator, denominator;
+
+        std::array<std::vector<float>, Constants::maxBands> bandDb;
+        std::array<BiquadCoefficients, Constants::maxBands> bandCoefficients;
+        std::array<double, Constants::maxBands> bandGridRate{}; // grid each band's curve was computed on
+        std::array<bool, Constants::maxBands> bandActive{};
+        int numBands = 0;
+        std::vector<float> curveDb;
+};
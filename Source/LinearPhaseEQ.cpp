@@ -0,0 +1,252 @@
+/*
+  ==============================================================================
+
+    LinearPhaseEQ.cpp
+    Created: 17 Oct 2026 6:41:05pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseEQ.h"
+
+namespace
+{
+    // Head partition of the non-uniform engine: small callbacks stay cheap,
+    // the long tail of the kernel is convolved in larger partitions
+    constexpr int headPartitionSize = 256;
+
+    // About 85 ms of kernel at any rate
+    constexpr double kernelSeconds = 0.085;
+}
+
+LinearPhaseEQ::LinearPhaseEQ()
+    : juce::Thread("Linear phase designer")
+{
+}
+
+LinearPhaseEQ::~LinearPhaseEQ()
+{
+    stopThread(1000);
+}
+
+void LinearPhaseEQ::prepare(const juce::dsp::ProcessSpec& spec, const std::vector<int>& channelIndices)
+{
+    // The designer talks to the engines, so it has to be parked while they are rebuilt
+    stopThread(1000);
+
+    preparedSpec = spec;
+    sampleRate = spec.sampleRate;
+    kernelLength = juce::jmax(256, juce::nextPowerOfTwo(juce::roundToInt(sampleRate * kernelSeconds))) - 1;
+    latency = (kernelLength - 1) / 2;
+
+    filteredChannels = channelIndices;
+    delayedChannels.clear();
+    for (int ch = 0; ch < static_cast<int>(spec.numChannels); ++ch)
+        if (std::find(channelIndices.begin(), channelIndices.end(), ch) == channelIndices.end())
+            delayedChannels.push_back(ch);
+
+    // The audio callback is stopped, so a release still waiting for it can happen right away
+    releaseEngines();
+    pendingRelease.store(0);
+
+    if (!active)
+        return;
+
+    createEngines();
+
+    // The last kernel was built for the old rate and engines
+    redesignPending = hasRequest;
+    startThread(juce::Thread::Priority::low);
+}
+
+juce::int64 LinearPhaseEQ::activate()
+{
+    // Parks the designer, including one still waiting to release the engines: the audio thread
+    // may not have seen the switch off yet, so engines that are still there are kept
+    stopThread(1000);
+    pendingRelease.store(0);
+    active = true;
+
+    if (convolutions.empty())
+    {
+        createEngines();
+        redesignPending = hasRequest;
+    }
+
+    startThread(juce::Thread::Priority::low);
+    return ++lastRequest;
+}
+
+juce::int64 LinearPhaseEQ::deactivate()
+{
+    active = false;
+    pendingRelease.store(++lastRequest);
+    notify();
+    return lastRequest;
+}
+
+void LinearPhaseEQ::createEngines()
+{
+    loaderQueue = std::make_unique<juce::dsp::ConvolutionMessageQueue>();
+
+    const juce::dsp::ProcessSpec pairSpec{ preparedSpec.sampleRate, preparedSpec.maximumBlockSize, 2 };
+    for (size_t i = 0; i < filteredChannels.size(); i += 2)
+    {
+        convolutions.push_back(std::make_unique<juce::dsp::Convolution>(
+            juce::dsp::Convolution::NonUniform{ headPartitionSize }, *loaderQueue));
+        convolutions.back()->prepare(pairSpec);
+    }
+
+    if (!delayedChannels.empty())
+    {
+        delay.setMaximumDelayInSamples(latency);
+        delay.prepare({ preparedSpec.sampleRate, preparedSpec.maximumBlockSize, static_cast<juce::uint32>(delayedChannels.size()) });
+        delay.setDelay(static_cast<float>(latency));
+    }
+}
+
+void LinearPhaseEQ::releaseEngines()
+{
+    // The engines go before the queue they load through
+    convolutions.clear();
+    loaderQueue.reset();
+}
+
+void LinearPhaseEQ::reset()
+{
+    for (auto& convolution : convolutions)
+        convolution->reset();
+
+    if (!delayedChannels.empty())
+        delay.reset();
+}
+
+void LinearPhaseEQ::process(const juce::dsp::AudioBlock<float>& block)
+{
+    const auto numSamples = block.getNumSamples();
+
+    // Filtered channels need not be adjacent (LFE sits in the middle of 5.1), so each pair gets its own view
+    for (size_t pair = 0; pair < convolutions.size(); ++pair)
+    {
+        std::array<float*, 2> pointers{};
+        size_t numPairChannels = 0;
+
+        for (size_t i = pair * 2; i < juce::jmin(pair * 2 + 2, filteredChannels.size()); ++i)
+            pointers[numPairChannels++] = block.getChannelPointer((size_t)filteredChannels[i]);
+
+        juce::dsp::AudioBlock<float> pairBlock(pointers.data(), numPairChannels, numSamples);
+        convolutions[pair]->process(juce::dsp::ProcessContextReplacing<float>(pairBlock));
+    }
+
+    for (size_t i = 0; i < delayedChannels.size(); ++i)
+    {
+        auto* data = block.getChannelPointer((size_t)delayedChannels[i]);
+
+        for (size_t n = 0; n < numSamples; ++n)
+        {
+            delay.pushSample(static_cast<int>(i), data[n]);
+            data[n] = delay.popSample(static_cast<int>(i));
+        }
+    }
+}
+
+void LinearPhaseEQ::requestDesign(const Coefficients& coefficients, double designRate)
+{
+    requests.getWriteBuffer() = { coefficients, designRate };
+    requests.publish();
+    notify();
+}
+
+void LinearPhaseEQ::run()
+{
+    while (!threadShouldExit())
+    {
+        // Switched off: free everything once the audio thread no longer plays through the engines, then end
+        if (const auto release = pendingRelease.load(); release != 0)
+        {
+            if (acknowledgedRequest.load(std::memory_order_acquire) >= release)
+            {
+                releaseEngines();
+                pendingRelease.store(0);
+                return;
+            }
+
+            wait(5);
+            continue;
+        }
+
+        if (requests.pull())
+        {
+            current = requests.getReadBuffer();
+            hasRequest = true;
+            redesignPending = true;
+        }
+
+        if (redesignPending)
+        {
+            redesignPending = false;
+            designKernel(current);
+        }
+
+        wait(-1);
+    }
+}
+
+void LinearPhaseEQ::designKernel(const Request& request)
+{
+    if (request.designRate <= 0.0 || convolutions.empty())
+        return;
+
+    // Frequency sampling on a grid twice the kernel length, so the zero-phase response fits without wrapping
+    const int fftOrder = juce::roundToInt(std::log2(kernelLength + 1)) + 1;
+    const int fftSize = 1 << fftOrder;
+    juce::dsp::FFT fft(fftOrder);
+
+    std::vector<float> data((size_t)fftSize * 2, 0.0f);
+    double magnitudeSum = 0.0;
+
+    for (int k = 0; k <= fftSize / 2; ++k)
+    {
+        // |H|^2 in the sin^2(w/2) form, as in FrequencyResponse
+        const double s = std::sin(juce::MathConstants<double>::pi * k * sampleRate / (fftSize * request.designRate));
+        const double phi = s * s;
+
+        auto evaluate = [phi](double x0, double x1, double x2)
+        {
+            return (x0 + x1 + x2) * (x0 + x1 + x2) - 4.0 * (x0 * x1 + x1 * x2 + 4.0 * x0 * x2) * phi
+                 + 16.0 * x0 * x2 * phi * phi;
+        };
+
+        double magnitudeSquared = 1.0;
+        for (const auto& c : request.coefficients)
+            magnitudeSquared *= evaluate(c.b0, c.b1, c.b2) / juce::jmax(1.0e-30, evaluate(1.0, c.a1, c.a2));
+
+        const double magnitude = std::sqrt(juce::jmax(0.0, magnitudeSquared));
+        data[(size_t)k * 2] = static_cast<float>(magnitude);
+        magnitudeSum += (k == 0 || k == fftSize / 2) ? magnitude : 2.0 * magnitude;
+    }
+
+    // Real, zero-phase spectrum in, symmetric impulse centred on sample 0 out
+    fft.performRealOnlyInverseTransform(data.data());
+
+    // FFT backends scale the inverse differently; the centre tap is the mean of the spectrum either way
+    if (data[0] == 0.0f)
+        return;
+
+    const float scale = static_cast<float>(magnitudeSum / fftSize) / data[0];
+
+    std::vector<float> window((size_t)kernelLength);
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), (size_t)kernelLength,
+        juce::dsp::WindowingFunction<float>::blackman, false);
+
+    juce::AudioBuffer<float> kernel(1, kernelLength);
+    auto* taps = kernel.getWritePointer(0);
+    for (int n = 0; n < kernelLength; ++n)
+        taps[n] = data[(size_t)((n - latency + fftSize) % fftSize)] * scale * window[(size_t)n];
+
+    // Each engine prepares its partitions on the loader queue and crossfades once it is ready
+    for (auto& convolution : convolutions)
+        convolution->loadImpulseResponse(juce::AudioBuffer<float>(kernel), sampleRate,
+            juce::dsp::Convolution::Stereo::no, juce::dsp::Convolution::Trim::no, juce::dsp::Convolution::Normalise::no);
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    LinearPhaseEQ.h
+    Created: 17 Oct 2026 6:41:05pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BiquadCascade.h"
+#include "Constants.h"
+#include "TripleBuffer.h"
+
+// Linear-phase version of the band curve. A background thread samples the
+// cascade's magnitude response, turns it into a symmetric FIR kernel and hands
+// it to juce::dsp::Convolution, whose non-uniformly partitioned engine runs it
+// with no extra latency beyond the kernel's own and crossfades to each new
+// kernel. Channels that are not filtered (LFE) are delayed by the same amount.
+//
+// The engines, their loader thread and the designer thread only exist while
+// linear phase is switched on: an EQ that never uses it costs no threads.
+class LinearPhaseEQ : private juce::Thread
+{
+    public:
+        using Coefficients = std::array<BiquadCoefficients, Constants::maxBands>;
+
+        LinearPhaseEQ();
+        ~LinearPhaseEQ() override;
+
+        // Not real-time safe. The kernel length (and so the latency) follows the sample rate.
+        void prepare(const juce::dsp::ProcessSpec& spec, const std::vector<int>& channelIndices);
+
+        // Message thread. Each returns a request number for the audio thread to acknowledge().
+        // activate() builds the engines (if they are not still there) before the switch is published.
+        // After deactivate() the designer thread frees them once the audio thread has acknowledged
+        // the switch, and then ends.
+        juce::int64 activate();
+        juce::int64 deactivate();
+
+        // Audio thread, with the request number of the state it is playing
+        void acknowledge(juce::int64 request) { acknowledgedRequest.store(request, std::memory_order_release); }
+
+        // Audio thread
+        void reset();
+        void process(const juce::dsp::AudioBlock<float>& block);
+
+        // Half the kernel length, fixed by prepare()
+        int getLatencyInSamples() const { return latency; }
+
+        // Message thread. Coefficients designed at designRate, which should be well above
+        // the device rate so the sampled curve is free of bilinear cramping.
+        void requestDesign(const Coefficients& coefficients, double designRate);
+
+    private:
+        struct Request
+        {
+            Coefficients coefficients;
+            double designRate = 0.0;
+        };
+
+        void run() override;
+        void designKernel(const Request& request);
+        void createEngines();
+        void releaseEngines();
+
+        // Message thread to designer thread, latest request wins
+        TripleBuffer<Request> requests;
+
+        // Designer thread (or prepare(), while that thread is stopped)
+        Request current;
+        bool hasRequest = false;
+        bool redesignPending = false;
+
+        // Message thread
+        bool active = false;
+        juce::int64 lastRequest = 0;
+
+        std::atomic<juce::int64> pendingRelease{ 0 }; // request number of a deactivate() still to carry out, 0 if none
+        std::atomic<juce::int64> acknowledgedRequest{ 0 };
+
+        juce::dsp::ProcessSpec preparedSpec{ 44100.0, 512, 0 };
+        double sampleRate = 44100.0;
+        int kernelLength = 0;
+        int latency = 0;
+
+        std::vector<int> filteredChannels;
+        std::vector<int> delayedChannels;
+
+        // One engine per pair of filtered channels, all loading kernels through one queue
+        std::unique_ptr<juce::dsp::ConvolutionMessageQueue> loaderQueue;
+        std::vector<std::unique_ptr<juce::dsp::Convolution>> convolutions;
+        juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> delay;
+};
@@ -7,6 +7,8 @@
 */
 
 #include <JuceHeader.h>
+#include "BatchRenderer.h"
+#include "EQDaemon.h"
 #include "MainComponent.h"
 
 //==============================================================================
@@ -25,6 +27,50 @@ public:
     {
         // This method is where you should put your application's initialisation code..
 
+        const auto args = getCommandLineParameterArray();
+
+        // Headless batch rendering, no window is created
+        if (BatchRenderer::isRenderCommand (args))
+        {
+            BatchRenderer::Options options;
+            const auto parseResult = BatchRenderer::parseCommandLine (args, options);
+
+            if (parseResult.failed())
+            {
+                std::cerr << parseResult.getErrorMessage() << std::endl;
+                setApplicationReturnValue (1);
+            }
+            else
+            {
+                setApplicationReturnValue (BatchRenderer::run (options));
+            }
+
+            quit();
+            return;
+        }
+
+        // Headless live processing on the audio device, runs until the process is asked to quit
+        if (EQDaemon::isDaemonCommand (args))
+        {
+            EQDaemon::Options options;
+            auto result = EQDaemon::parseCommandLine (args, options);
+
+            if (result.wasOk())
+            {
+                daemon.reset (new EQDaemon (options));
+                result = daemon->start();
+            }
+
+            if (result.failed())
+            {
+                std::cerr << result.getErrorMessage() << std::endl;
+                setApplicationReturnValue (1);
+                quit();
+            }
+
+            return;
+        }
+
         mainWindow.reset (new MainWindow (getApplicationName()));
     }
 
@@ -33,6 +79,7 @@ public:
         // Add your application's shutdown code here..
 
         mainWindow = nullptr; // (deletes our window)
+        daemon = nullptr;
     }
 
     //==============================================================================
@@ -98,6 +145,7 @@ public:
 
 private:
     std::unique_ptr<MainWindow> mainWindow;
+    std::unique_ptr<EQDaemon> daemon;
 };
 
 //==============================================================================
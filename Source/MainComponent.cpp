@@ -3,12 +3,24 @@
 //==============================================================================
 MainComponent::MainComponent()
 {
+    // Lookup table is built here, so the audio thread only reads it
+    testTone.initialise([](float x) { return std::sin(x); }, 128);
+    testTone.setFrequency(440.0f, true);
 
+    eqUI.setPerformanceMonitor(performance);
     addAndMakeVisible(eqUI);
+
+    // In the UI's header row, laid out with its controls
+    testToneButton.onClick = [this]() { testToneEnabled = testToneButton.getToggleState(); };
+    eqUI.addHeaderControl(testToneButton, 100);
     // Make sure you set the size of the component after
     // you add any child components.
     setSize (800, 600);
 
+    remoteControl.openMidiInputs();
+    if (auto result = remoteControl.openOsc(); result.failed())
+        DBG(result.getErrorMessage());
+
     // Some platforms require permissions to open input channels so request that here
     if (juce::RuntimePermissions::isRequired (juce::RuntimePermissions::recordAudio)
         && ! juce::RuntimePermissions::isGranted (juce::RuntimePermissions::recordAudio))
@@ -36,27 +48,46 @@ void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRat
     juce::dsp::ProcessSpec spec;
     spec.sampleRate = sampleRate;
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlockExpected);
-    spec.numChannels = 1;
 
-    eq.prepare(spec);
+    // Prepare for every output channel the device opened, not just one
+    auto* device = deviceManager.getCurrentAudioDevice();
+    spec.numChannels = device != nullptr
+        ? static_cast<juce::uint32>(device->getActiveOutputChannels().countNumberOfSetBits())
+        : 2;
 
-    // Sync the EQ bands with the current slider values
-    for (int i = 0; i < eqUI.eqNodes.size(); ++i)
-        eqUI.handleSliderChange(i);
+    // Redesigns the latest published bands at the new rate; the UI is never touched from here
+    eq.prepare(spec);
+    testTone.prepare(spec);
+    analyzer.prepare(sampleRate);
+    performance.prepare(sampleRate);
 }
 
 void MainComponent::getNextAudioBlock (const juce::AudioSourceChannelInfo& bufferToFill)
 {
-    juce::AudioBuffer<float> sineWave = generateSineWave(bufferToFill.numSamples, 2);
-    eq.process(sineWave);
-    for (int i = 0; i < bufferToFill.numSamples; ++i)
+    EQ_TRACE_SCOPE("getNextAudioBlock");
+
+    juce::ScopedNoDenormals noDenormals;
+
+    PerformanceMonitor::ScopedCallback timing(performance, bufferToFill.numSamples);
+
+    // The device buffer already holds the live input, so everything happens in place
+    auto block = juce::dsp::AudioBlock<float>(*bufferToFill.buffer)
+                     .getSubBlock(static_cast<size_t>(bufferToFill.startSample),
+                                  static_cast<size_t>(bufferToFill.numSamples));
+
+    if (testToneEnabled.load(std::memory_order_relaxed))
     {
-        float leftSample = sineWave.getSample(0, i);
-        float rightSample = sineWave.getSample(1, i);
-        bufferToFill.buffer->setSample(0, i, leftSample);
-        bufferToFill.buffer->setSample(1, i, rightSample);
-        
+        block.clear();
+        testTone.process(juce::dsp::ProcessContextReplacing<float>(block));
     }
+
+    // Only copies into the analyzer's FIFOs, the FFTs run on its own thread
+    analyzer.pushBlock(SpectrumAnalyzer::PreEQ, block);
+    {
+        PerformanceMonitor::ScopedEQ eqTiming(timing);
+        eq.process(block);
+    }
+    analyzer.pushBlock(SpectrumAnalyzer::PostEQ, block);
 }
 
 void MainComponent::releaseResources()
@@ -80,26 +111,3 @@ void MainComponent::resized()
 {
     eqUI.setBounds(getLocalBounds());
 }
-
-// ============== Helper functions ============== //
-
-juce::AudioBuffer<float> MainComponent::generateSineWave(int numSamples, int numChannels)
-{
-    static float phase = 0.0f;
-    const float frequency = 440.0f;
-    const float sampleRate = eq.getSampleRate();
-    juce::AudioBuffer<float> tempBuffer(numChannels, numSamples);
-
-    for (int i = 0; i < numSamples; ++i)
-    {
-        float sample = std::sin(phase);
-        phase += 2.0f * juce::MathConstants<float>::pi * frequency / sampleRate;
-        if (phase >= 2.0f * juce::MathConstants<float>::pi)
-            phase -= 2.0f * juce::MathConstants<float>::pi;
-
-        tempBuffer.setSample(0, i, sample);
-        tempBuffer.setSample(1, i, sample);
-    }
-
-    return tempBuffer;
-}
\ No newline at end of file
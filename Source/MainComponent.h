@@ -1,7 +1,11 @@
 #pragma once
 
+#include "EQParameters.h"
 #include "EQProcessor.h"
 #include "EQUI.h"
+#include "PerformanceMonitor.h"
+#include "RemoteControl.h"
+#include "SpectrumAnalyzer.h"
 #include <JuceHeader.h>
 
 //==============================================================================
@@ -32,10 +36,24 @@ private:
     // DSP
     EQProcessor eq;
 
-    // UI
-    EQUI eqUI{ eq };
+    // Band state and A/B presets, edited by the UI and pushed to eq
+    EQParameters parameters{ eq };
 
-    juce::AudioBuffer<float> generateSineWave(int numSamples, int numChannels);
+    // MIDI CC and local OSC, straight to the audio thread
+    RemoteControl remoteControl{ eq, parameters };
+
+    // Optional 440 Hz test tone, rendered straight into the device buffer instead of the input
+    juce::dsp::Oscillator<float> testTone;
+    std::atomic<bool> testToneEnabled{ false };
+
+    SpectrumAnalyzer analyzer;
+
+    // Timing of every getNextAudioBlock() call, shown by the UI on request
+    PerformanceMonitor performance;
+
+    // UI. The test tone toggle sits in eqUI's header row, so it is declared first to outlive it.
+    juce::ToggleButton testToneButton{ "Test tone" };
+    EQUI eqUI{ eq, parameters, analyzer };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
 };
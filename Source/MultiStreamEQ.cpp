@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    MultiStreamEQ.cpp
+    Created: 18 Oct 2026 11:27:53am
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "MultiStreamEQ.h"
+
+// Sleeps until the audio thread opens a block, then takes its share and steals from the others
+class MultiStreamEQ::Worker : public juce::Thread
+{
+    public:
+        Worker(MultiStreamEQ& engine, int participantIndex)
+            : juce::Thread("EQ stream worker " + juce::String(participantIndex)),
+              owner(engine), participant(participantIndex) {}
+
+        ~Worker() override
+        {
+            signalThreadShouldExit();
+            notify();
+            stopThread(1000);
+        }
+
+    private:
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                wait(-1.0);
+                if (threadShouldExit())
+                    break;
+
+                owner.numCheckedIn.fetch_add(1);
+                if (owner.blockOpen.load())
+                    owner.runShares(participant);
+                owner.numCheckedIn.fetch_sub(1);
+            }
+        }
+
+        MultiStreamEQ& owner;
+        const int participant;
+};
+
+MultiStreamEQ::MultiStreamEQ(int numWorkerThreads)
+{
+    for (int i = 0; i < juce::jmax(0, numWorkerThreads); ++i)
+        workers.push_back(std::make_unique<Worker>(*this, i + 1));
+
+    shares = std::make_unique<Share[]>(workers.size() + 1);
+}
+
+MultiStreamEQ::~MultiStreamEQ()
+{
+    closeBlock();
+    workers.clear();
+}
+
+void MultiStreamEQ::prepare(double newSampleRate, int maximumBlockSize, int numStreams, int numChannelsPerStream)
+{
+    closeBlock();
+
+    sampleRate = newSampleRate;
+    channelsPerStream = juce::jmax(1, numChannelsPerStream);
+
+    streams.resize((size_t)juce::jmax(0, numStreams));
+    for (auto& stream : streams)
+    {
+        if (stream == nullptr)
+            stream = std::make_unique<EQProcessor>();
+
+        stream->prepare({ sampleRate, static_cast<juce::uint32>(maximumBlockSize), static_cast<juce::uint32>(channelsPerStream) });
+    }
+
+    blockChannels.assign(streams.size() * (size_t)channelsPerStream, nullptr);
+
+    // Lets the OS schedule the workers like audio threads (and join the device's workgroup on macOS)
+    const auto options = juce::Thread::RealtimeOptions{}.withApproximateAudioProcessingTime(maximumBlockSize, sampleRate);
+    for (auto& worker : workers)
+        if (!worker->isThreadRunning())
+            worker->startRealtimeThread(options);
+}
+
+void MultiStreamEQ::process(juce::AudioBuffer<float>& buffer)
+{
+    process(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), buffer.getNumSamples());
+}
+
+void MultiStreamEQ::process(float* const* channels, int numChannels, int numSamples)
+{
+    EQ_TRACE_SCOPE("MultiStreamEQ::process");
+
+    const int numStreams = juce::jmin(getNumStreams(), numChannels / channelsPerStream);
+    if (numStreams == 0 || numSamples == 0)
+        return;
+
+    // A worker that woke late for the previous block may still be looking at it
+    closeBlock();
+
+    std::copy(channels, channels + numStreams * channelsPerStream, blockChannels.begin());
+    blockSamples = numSamples;
+    blockStreams = numStreams;
+
+    if (workers.empty() || numStreams < fanOutThreshold.load(std::memory_order_relaxed))
+    {
+        processInline();
+        return;
+    }
+
+    const auto budget = deadlineProportion.load(std::memory_order_relaxed) * numSamples / sampleRate;
+    blockDeadline = juce::Time::getHighResolutionTicks()
+                  + static_cast<juce::int64>(budget * static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()));
+    pastDeadline.store(false, std::memory_order_relaxed);
+    numRemaining.store(numStreams, std::memory_order_relaxed);
+
+    // Contiguous shares, no more participants than streams
+    const int numShares = static_cast<int>(workers.size()) + 1;
+    const int numParticipants = juce::jmin(numShares, numStreams);
+    for (int p = 0; p < numShares; ++p)
+    {
+        const int begin = p < numParticipants ? p * numStreams / numParticipants : 0;
+        shares[p].end = p < numParticipants ? (p + 1) * numStreams / numParticipants : 0;
+        shares[p].next.store(begin, std::memory_order_relaxed);
+    }
+
+    blockOpen.store(true);
+    for (int w = 0; w < numParticipants - 1; ++w)
+        workers[(size_t)w]->notify();
+
+    runShares(0);
+
+    // Everything is claimed by now, only streams still running on workers are left
+    while (numRemaining.load(std::memory_order_acquire) > 0)
+        juce::Thread::yield();
+
+    if (pastDeadline.load(std::memory_order_relaxed) || juce::Time::getHighResolutionTicks() > blockDeadline)
+        deadlineMisses.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MultiStreamEQ::processInline()
+{
+    for (int s = 0; s < blockStreams; ++s)
+        streams[(size_t)s]->process(juce::dsp::AudioBlock<float>(blockChannels.data() + s * channelsPerStream,
+                                                                  (size_t)channelsPerStream, (size_t)blockSamples));
+}
+
+void MultiStreamEQ::runShares(int participant)
+{
+    const int numShares = static_cast<int>(workers.size()) + 1;
+
+    // Own share first, then the others in turn
+    for (int k = 0; k < numShares; ++k)
+    {
+        auto& share = shares[(participant + k) % numShares];
+
+        while (share.next.load(std::memory_order_relaxed) < share.end)
+        {
+            const int streamIndex = share.next.fetch_add(1, std::memory_order_relaxed);
+            if (streamIndex >= share.end)
+                break;
+
+            processClaimedStream(streamIndex);
+            numRemaining.fetch_sub(1, std::memory_order_release);
+        }
+    }
+}
+
+void MultiStreamEQ::processClaimedStream(int streamIndex)
+{
+    if (!pastDeadline.load(std::memory_order_relaxed) && juce::Time::getHighResolutionTicks() > blockDeadline)
+        pastDeadline.store(true, std::memory_order_relaxed);
+
+    // Too late to start: the stream plays dry this block rather than the whole callback running over
+    if (pastDeadline.load(std::memory_order_relaxed))
+    {
+        skippedStreams.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    streams[(size_t)streamIndex]->process(juce::dsp::AudioBlock<float>(blockChannels.data() + streamIndex * channelsPerStream,
+                                                                       (size_t)channelsPerStream, (size_t)blockSamples));
+}
+
+void MultiStreamEQ::closeBlock()
+{
+    // Sequentially consistent with the workers' check-in: once the count is seen at zero,
+    // any later check-in sees the block closed (or the next one fully written)
+    blockOpen.store(false);
+    while (numCheckedIn.load() > 0)
+        juce::Thread::yield();
+}
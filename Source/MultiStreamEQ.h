@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    MultiStreamEQ.h
+    Created: 18 Oct 2026 11:27:53am
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "EQProcessor.h"
+
+// Many independent EQs in one audio callback, e.g. one per microphone on a
+// console. Stream s filters channels [s * channelsPerStream, (s + 1) * channelsPerStream)
+// with its own EQProcessor and curve.
+//
+// With enough streams the block is fanned out over a pool of real-time worker
+// threads. The calling thread works too. Each participant starts on its own
+// contiguous share of the streams, so a stream tends to stay on one core from block
+// to block. A participant that runs out steals from the others' shares one stream at a time.
+//
+// The join is deadline-aware. Once deadlineProportion of the block's duration has passed,
+// streams nobody has started yet are left dry instead of processed, and the block
+// counts as a deadline miss. Streams already running are always finished.
+//
+// Streams in linear phase each start their own engine threads, so keep large
+// stream counts minimum phase. Tracing: the workers hold a TraceRecorder ring for as
+// long as they run. With more than TraceRecorder::maxThreads traced threads (workers,
+// audio and message thread together), EQ_TRACE_SCOPE on the rest records nothing,
+// and the trace reports them as dropped threads.
+class MultiStreamEQ
+{
+    public:
+        // Below this many streams the calling thread does everything, waking workers costs more
+        static constexpr int defaultFanOutThreshold = 8;
+
+        // One worker per physical core besides the audio thread's by default
+        explicit MultiStreamEQ(int numWorkerThreads = juce::SystemStats::getNumPhysicalCpus() - 1);
+        ~MultiStreamEQ();
+
+        // Not real-time safe, the audio callback must be stopped. Keeps existing streams (and their curves)
+        // up to numStreams, adds new ones with the default curve and starts the workers.
+        void prepare(double sampleRate, int maximumBlockSize, int numStreams, int channelsPerStream = 1);
+
+        int getNumStreams() const { return static_cast<int>(streams.size()); }
+        int getChannelsPerStream() const { return channelsPerStream; }
+        int getNumWorkerThreads() const { return static_cast<int>(workers.size()); }
+
+        // Message thread: curves, oversampling and linear phase of each stream, as for a single EQProcessor
+        EQProcessor& getStream(int streamIndex) { return *streams[(size_t)streamIndex]; }
+
+        // Audio thread, processes in place. Channels past the last stream pass through.
+        void process(float* const* channels, int numChannels, int numSamples);
+        void process(juce::AudioBuffer<float>& buffer);
+
+        // Any thread
+        void setFanOutThreshold(int minimumStreams) { fanOutThreshold.store(juce::jmax(1, minimumStreams), std::memory_order_relaxed); }
+        void setDeadlineProportion(double proportion) { deadlineProportion.store(juce::jlimit(0.05, 1.0, proportion), std::memory_order_relaxed); }
+
+        // Any thread. Blocks where the deadline passed, and streams left dry because of it.
+        juce::int64 getNumDeadlineMisses() const { return deadlineMisses.load(std::memory_order_relaxed); }
+        juce::int64 getNumSkippedStreams() const { return skippedStreams.load(std::memory_order_relaxed); }
+
+    private:
+        class Worker;
+
+        // One participant's share of the streams. Owner and thieves claim alike, with fetch_add on next.
+        struct alignas(64) Share
+        {
+            std::atomic<int> next{ 0 };
+            int end = 0;
+        };
+
+        void processInline();
+        void runShares(int participant);
+        void processClaimedStream(int streamIndex);
+        void closeBlock();
+
+        std::vector<std::unique_ptr<EQProcessor>> streams;
+        std::vector<std::unique_ptr<Worker>> workers;
+        int channelsPerStream = 1;
+        double sampleRate = 44100.0;
+
+        std::atomic<int> fanOutThreshold{ defaultFanOutThreshold };
+        std::atomic<double> deadlineProportion{ 0.8 };
+        std::atomic<juce::int64> deadlineMisses{ 0 }, skippedStreams{ 0 };
+
+        // The current block, written by the audio thread while the block is closed
+        std::vector<float*> blockChannels;
+        int blockSamples = 0;
+        int blockStreams = 0;
+        juce::int64 blockDeadline = 0;
+        std::unique_ptr<Share[]> shares; // [0] is the audio thread's, then one per worker
+
+        // Workers only touch the block while checked in (numCheckedIn), and only check in while it is open,
+        // so the audio thread can rewrite it once it has closed it and seen the count drop to zero
+        std::atomic<bool> blockOpen{ false };
+        std::atomic<int> numCheckedIn{ 0 };
+        std::atomic<int> numRemaining{ 0 };
+        std::atomic<bool> pastDeadline{ false };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultiStreamEQ)
+};
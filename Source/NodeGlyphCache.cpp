@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    NodeGlyphCache.cpp
+    Created: 17 Oct 2026 11:26:54am
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "NodeGlyphCache.h"
+
+void NodeGlyphCache::setScale(float newScale)
+{
+    if (newScale == scale)
+        return;
+
+    scale = newScale;
+
+    for (auto& band : glyphs)
+        for (auto& state : band)
+            for (auto& image : state)
+                image = {};
+}
+
+const juce::Image& NodeGlyphCache::getGlyph(int bandIndex, bool hovered, float Q)
+{
+    float qNorm = juce::jmap(juce::jlimit(Constants::minQ, Constants::maxQ, Q), Constants::minQ, Constants::maxQ, 0.0f, 1.0f);
+    int bucket = juce::roundToInt(qNorm * (numQBuckets - 1));
+
+    auto& image = glyphs[bandIndex][hovered ? 1 : 0][bucket];
+
+    // Rendered on first use only
+    if (image.isNull())
+    {
+        const int size = juce::roundToInt(glyphSize * scale);
+        image = juce::Image(juce::Image::ARGB, size, size, true);
+
+        juce::Graphics g(image);
+        g.addTransform(juce::AffineTransform::scale(scale));
+
+        float bucketQ = juce::jmap((float)bucket / (numQBuckets - 1), Constants::minQ, Constants::maxQ);
+        renderGlyph(g, bandIndex, hovered, bucketQ);
+    }
+
+    return image;
+}
+
+void NodeGlyphCache::renderGlyph(juce::Graphics& g, int bandIndex, bool hovered, float Q) const
+{
+    const juce::Point<float> centre{ glyphSize * 0.5f, glyphSize * 0.5f };
+    const auto circle = juce::Rectangle<float>(24.0f, 24.0f).withCentre(centre);
+
+    // fill ellipse with transparent background of appropriate colour
+    float alpha = hovered ? 0.4f : 0.2f;
+    g.setColour(Constants::getBandColour(bandIndex).withAlpha(alpha));
+    g.fillEllipse(circle);
+
+    // black outline
+    g.setColour(juce::Colours::black);
+    g.drawEllipse(circle, 2);
+
+    g.setFont(20.0f);
+
+    juce::String label = juce::String(bandIndex + 1);
+
+    // First, draw black outline around the text by offsetting it in all directions
+    g.setColour(juce::Colours::black);
+    for (int dx = -1; dx <= 1; ++dx)
+    {
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            if (dx != 0 || dy != 0)
+                g.drawText(label, circle.translated((float)dx, (float)dy), juce::Justification::centred, false);
+        }
+    }
+
+    // Then draw the number of the band (index + 1)
+    g.setColour(Constants::getBandColour(bandIndex).interpolatedWith(juce::Colours::white, 0.75f));
+    g.drawText(label, circle, juce::Justification::centred, false);
+
+    // Add some rings to the outside
+    float qNorm = juce::jmap(Q, Constants::minQ, Constants::maxQ, 0.0f, 1.0f);
+    float arcSpanRadians = juce::jmap(
+        qNorm,
+        0.0f,
+        1.0f,
+        0.0f,
+        juce::MathConstants<float>::halfPi); // 0 to 90 degrees (in rads)
+
+    float radius = 12.0f;
+    juce::Path rings;
+
+    // upper left, upper right, lower left, lower right
+    rings.addCentredArc(centre.x, centre.y, radius, radius, 0.0f, 0.0f, -1 * arcSpanRadians, true);
+    rings.addCentredArc(centre.x, centre.y, radius, radius, 0.0f, 0.0f, arcSpanRadians, true);
+    rings.addCentredArc(centre.x, centre.y, radius, radius, 0.0f,
+        juce::MathConstants<float>::pi, juce::MathConstants<float>::pi + arcSpanRadians, true);
+    rings.addCentredArc(centre.x, centre.y, radius, radius, 0.0f,
+        juce::MathConstants<float>::pi, juce::MathConstants<float>::pi - arcSpanRadians, true);
+
+    g.setColour(Constants::getBandColour(bandIndex));
+    g.strokePath(rings, juce::PathStrokeType(2.0f));
+
+    // Finally, add some contour to the rings
+    float contourRadius = 14.0f;
+    float contourThickness = 2.0f;
+
+    g.setColour(juce::Colours::black);
+    g.drawEllipse(juce::Rectangle<float>(contourRadius * 2.0f, contourRadius * 2.0f).withCentre(centre),
+        contourThickness);
+}
@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    NodeGlyphCache.h
+    Created: 17 Oct 2026 11:26:54am
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Constants.h"
+
+// Pre-rendered EQ node glyphs (fill, outline, outlined band number, Q rings and
+// contour), keyed by band, hover state and a quantised Q. Drawing a node is
+// then a single image blit instead of paths and nine text passes.
+class NodeGlyphCache
+{
+    public:
+        // Logical size of a glyph; the contour ring (14px + 2px stroke) fits inside
+        static constexpr float glyphSize = 36.0f;
+
+        // Q ring spans are quantised to this many steps (under 1.5 degrees each)
+        static constexpr int numQBuckets = 64;
+
+        NodeGlyphCache() = default;
+
+        // Drops every glyph if the display scale changed
+        void setScale(float newScale);
+
+        const juce::Image& getGlyph(int bandIndex, bool hovered, float Q);
+
+    private:
+        void renderGlyph(juce::Graphics& g, int bandIndex, bool hovered, float Q) const;
+
+        float scale = 1.0f;
+        std::array<std::array<std::array<juce::Image, numQBuckets>, 2>, Constants::maxBands> glyphs;
+};
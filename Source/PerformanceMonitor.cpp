@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    PerformanceMonitor.cpp
+    Created: 17 Oct 2026 9:05:33pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "PerformanceMonitor.h"
+
+PerformanceMonitor::PerformanceMonitor()
+    : ticksPerMs(static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / 1000.0)
+{
+    if (isEnabled())
+        records.resize(static_cast<size_t>(fifo.getTotalSize()));
+
+    reset();
+}
+
+void PerformanceMonitor::push(const Record& record) noexcept
+{
+    const auto scope = fifo.write(1);
+    if (scope.blockSize1 + scope.blockSize2 == 0)
+    {
+        numDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    records[static_cast<size_t>(scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)] = record;
+}
+
+void PerformanceMonitor::update()
+{
+    const double rate = sampleRate.load(std::memory_order_relaxed);
+    auto& s = statistics;
+
+    auto fold = [&](const Record& record)
+    {
+        const double periodMs = 1000.0 * record.numSamples / rate;
+        const double ms = static_cast<double>(record.callbackTicks) / ticksPerMs;
+        const double eqMs = static_cast<double>(record.eqTicks) / ticksPerMs;
+        const double load = periodMs > 0.0 ? ms / periodMs : 0.0;
+        const double eqLoad = periodMs > 0.0 ? eqMs / periodMs : 0.0;
+
+        s.minMs = s.numCallbacks == 0 ? ms : juce::jmin(s.minMs, ms);
+        s.maxMs = juce::jmax(s.maxMs, ms);
+        s.eqMaxMs = juce::jmax(s.eqMaxMs, eqMs);
+        s.maxLoad = juce::jmax(s.maxLoad, load);
+        s.eqMaxLoad = juce::jmax(s.eqMaxLoad, eqLoad);
+
+        if (load > 1.0)
+            ++s.numOverruns;
+
+        ++s.loadHistogram[(size_t)juce::jlimit(0, numHistogramBins - 1, static_cast<int>(load * 100.0))];
+        ++s.eqLoadHistogram[(size_t)juce::jlimit(0, numHistogramBins - 1, static_cast<int>(eqLoad * 100.0))];
+
+        totalMs += ms;
+        totalEqMs += eqMs;
+        totalPeriodMs += periodMs;
+        totalLoad += load;
+        totalEqLoad += eqLoad;
+        ++s.numCallbacks;
+    };
+
+    const auto scope = fifo.read(fifo.getNumReady());
+    for (int i = 0; i < scope.blockSize1; ++i)
+        fold(records[static_cast<size_t>(scope.startIndex1 + i)]);
+    for (int i = 0; i < scope.blockSize2; ++i)
+        fold(records[static_cast<size_t>(scope.startIndex2 + i)]);
+
+    s.numDropped = numDropped.load(std::memory_order_relaxed) - droppedAtReset;
+
+    if (s.numCallbacks == 0)
+        return;
+
+    const auto n = static_cast<double>(s.numCallbacks);
+    s.meanMs = totalMs / n;
+    s.eqMeanMs = totalEqMs / n;
+    s.meanLoad = totalLoad / n;
+    s.eqMeanLoad = totalEqLoad / n;
+
+    // Percentiles come from the load histograms, in ms at the average block period.
+    // A bin's upper edge can overshoot the largest value seen, which bounds them too.
+    s.p99Load = juce::jmin(s.maxLoad, getPercentile(s.loadHistogram, s.numCallbacks, 0.99));
+    s.eqP99Load = juce::jmin(s.eqMaxLoad, getPercentile(s.eqLoadHistogram, s.numCallbacks, 0.99));
+    s.p99Ms = s.p99Load * totalPeriodMs / n;
+    s.eqP99Ms = s.eqP99Load * totalPeriodMs / n;
+}
+
+void PerformanceMonitor::reset()
+{
+    // Whatever is still queued belongs to before the reset
+    fifo.read(fifo.getNumReady());
+
+    statistics = {};
+    totalMs = totalEqMs = totalPeriodMs = totalLoad = totalEqLoad = 0.0;
+    droppedAtReset = numDropped.load(std::memory_order_relaxed);
+}
+
+double PerformanceMonitor::getPercentile(const std::array<juce::uint32, numHistogramBins>& histogram, juce::int64 count, double fraction)
+{
+    // Upper edge of the bin the fraction falls in
+    const auto target = static_cast<juce::int64>(std::ceil(fraction * static_cast<double>(count)));
+    juce::int64 cumulative = 0;
+
+    for (int bin = 0; bin < numHistogramBins; ++bin)
+    {
+        cumulative += histogram[(size_t)bin];
+        if (cumulative >= target)
+            return (bin + 1) / 100.0;
+    }
+
+    return numHistogramBins / 100.0;
+}
+
+juce::Result PerformanceMonitor::writeReport(const juce::File& file) const
+{
+    if (!isEnabled())
+        return juce::Result::fail("Timing was compiled out (EQ_PERFORMANCE_MONITOR=0)");
+
+    const auto& s = statistics;
+    juce::String text;
+
+    text << "EQ callback timing, " << juce::Time::getCurrentTime().toString(true, true) << "\n"
+         << "Sample rate: " << juce::String(sampleRate.load(), 0) << " Hz\n"
+         << "Callbacks: " << s.numCallbacks << ", overruns: " << s.numOverruns << ", dropped records: " << s.numDropped << "\n"
+         << "Callback ms: min " << juce::String(s.minMs, 4) << ", mean " << juce::String(s.meanMs, 4)
+         << ", p99 " << juce::String(s.p99Ms, 4) << ", max " << juce::String(s.maxMs, 4) << "\n"
+         << "EQ ms: mean " << juce::String(s.eqMeanMs, 4) << ", p99 " << juce::String(s.eqP99Ms, 4)
+         << ", max " << juce::String(s.eqMaxMs, 4) << "\n"
+         << "Load % of block period: mean " << juce::String(100.0 * s.meanLoad, 2) << ", p99 " << juce::String(100.0 * s.p99Load, 2)
+         << ", max " << juce::String(100.0 * s.maxLoad, 2) << ", EQ mean " << juce::String(100.0 * s.eqMeanLoad, 2) << "\n\n"
+         << "load_percent,callbacks,eq\n";
+
+    // Each row counts loads from load_percent up to the next percent, the last row everything above
+    for (int bin = 0; bin < numHistogramBins; ++bin)
+        if (s.loadHistogram[(size_t)bin] != 0 || s.eqLoadHistogram[(size_t)bin] != 0)
+            text << bin << "," << (int)s.loadHistogram[(size_t)bin] << "," << (int)s.eqLoadHistogram[(size_t)bin] << "\n";
+
+    if (!file.replaceWithText(text))
+        return juce::Result::fail("Could not write " + file.getFullPathName());
+
+    return juce::Result::ok();
+}
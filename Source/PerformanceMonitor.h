@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+    PerformanceMonitor.h
+    Created: 17 Oct 2026 9:05:33pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Set to 0 (e.g. in the exporter's preprocessor definitions) to compile the timing out entirely:
+// the scopes become empty and nothing is measured or stored.
+#ifndef EQ_PERFORMANCE_MONITOR
+ #define EQ_PERFORMANCE_MONITOR 1
+#endif
+
+// Timing of every audio callback against its deadline (the block period).
+// The audio thread only reads the high-resolution clock and pushes one small
+// record per callback into a wait-free FIFO; statistics and histograms are
+// built from those records on the message thread.
+class PerformanceMonitor
+{
+    public:
+        // Load in 1 % steps of the block period, the last bin collects everything from 200 % up
+        static constexpr int numHistogramBins = 201;
+
+        struct Statistics
+        {
+            juce::int64 numCallbacks = 0;
+            juce::int64 numOverruns = 0;  // callbacks that took longer than their block period
+            juce::int64 numDropped = 0;   // records lost because the FIFO was not drained in time
+
+            // Whole callback, and the part spent in EQProcessor::process
+            double minMs = 0.0, meanMs = 0.0, p99Ms = 0.0, maxMs = 0.0;
+            double eqMeanMs = 0.0, eqP99Ms = 0.0, eqMaxMs = 0.0;
+
+            // Callback time over block period, 1.0 is the deadline
+            double meanLoad = 0.0, p99Load = 0.0, maxLoad = 0.0;
+            double eqMeanLoad = 0.0, eqP99Load = 0.0, eqMaxLoad = 0.0;
+
+            std::array<juce::uint32, numHistogramBins> loadHistogram{};
+            std::array<juce::uint32, numHistogramBins> eqLoadHistogram{};
+        };
+
+        static constexpr bool isEnabled() { return EQ_PERFORMANCE_MONITOR != 0; }
+
+        PerformanceMonitor();
+
+        // Before audio starts
+        void prepare(double newSampleRate) { sampleRate = newSampleRate; }
+
+        class ScopedEQ;
+
+       #if EQ_PERFORMANCE_MONITOR
+        // Audio thread: measures one callback, from construction to destruction
+        class ScopedCallback
+        {
+            public:
+                ScopedCallback(PerformanceMonitor& owner, int numSamples) noexcept
+                    : monitor(owner), samples(numSamples), start(juce::Time::getHighResolutionTicks()) {}
+
+                ~ScopedCallback() { monitor.push({ juce::Time::getHighResolutionTicks() - start, eqTicks, samples }); }
+
+            private:
+                friend class ScopedEQ;
+                PerformanceMonitor& monitor;
+                const int samples;
+                const juce::int64 start;
+                juce::int64 eqTicks = 0;
+
+                JUCE_DECLARE_NON_COPYABLE(ScopedCallback)
+        };
+
+        // Audio thread, inside a ScopedCallback: adds the time until destruction to the EQ share
+        class ScopedEQ
+        {
+            public:
+                explicit ScopedEQ(ScopedCallback& callback) noexcept
+                    : owner(callback), start(juce::Time::getHighResolutionTicks()) {}
+
+                ~ScopedEQ() { owner.eqTicks += juce::Time::getHighResolutionTicks() - start; }
+
+            private:
+                ScopedCallback& owner;
+                const juce::int64 start;
+
+                JUCE_DECLARE_NON_COPYABLE(ScopedEQ)
+        };
+       #else
+        class ScopedCallback
+        {
+            public:
+                ScopedCallback(PerformanceMonitor&, int) noexcept {}
+        };
+
+        class ScopedEQ
+        {
+            public:
+                explicit ScopedEQ(ScopedCallback&) noexcept {}
+        };
+       #endif
+
+        // Message thread (or whichever single thread reads the statistics).
+        // Folds the records that arrived since the last call into the statistics.
+        void update();
+        void reset();
+        const Statistics& getStatistics() const { return statistics; }
+
+        // Statistics and both histograms as text, for comparing machines and settings
+        juce::Result writeReport(const juce::File& file) const;
+
+    private:
+        struct Record
+        {
+            juce::int64 callbackTicks;
+            juce::int64 eqTicks;
+            int numSamples;
+        };
+
+        void push(const Record& record) noexcept;
+        static double getPercentile(const std::array<juce::uint32, numHistogramBins>& histogram, juce::int64 count, double fraction);
+
+        std::atomic<double> sampleRate{ 44100.0 };
+        const double ticksPerMs;
+
+        // Audio thread to reader, a few seconds' worth even at small block sizes
+        juce::AbstractFifo fifo{ 1 << 13 };
+        std::vector<Record> records;
+        std::atomic<juce::int64> numDropped{ 0 };
+
+        // Reader only
+        Statistics statistics;
+        double totalMs = 0.0, totalEqMs = 0.0, totalPeriodMs = 0.0;
+        double totalLoad = 0.0, totalEqLoad = 0.0;
+        juce::int64 droppedAtReset = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PerformanceMonitor)
+};
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    PerformanceOverlay.cpp
+    Created: 17 Oct 2026 9:05:33pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "PerformanceOverlay.h"
+
+PerformanceOverlay::PerformanceOverlay(PerformanceMonitor& performanceMonitor)
+    : monitor(performanceMonitor)
+{
+    saveButton.onClick = [this]() { saveReport(); };
+    saveButton.setEnabled(PerformanceMonitor::isEnabled());
+    addAndMakeVisible(saveButton);
+
+    startTimerHz(4);
+}
+
+void PerformanceOverlay::timerCallback()
+{
+    monitor.update();
+
+    if (isShowing())
+        repaint();
+}
+
+void PerformanceOverlay::resized()
+{
+    saveButton.setBounds(getWidth() - 58, 6, 52, 20);
+}
+
+void PerformanceOverlay::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+    g.setColour(juce::Colours::black.withAlpha(0.75f));
+    g.fillRoundedRectangle(bounds, 6.0f);
+
+    auto area = getLocalBounds().reduced(8, 6);
+    g.setColour(juce::Colours::white);
+    g.setFont(12.0f);
+
+    if (!PerformanceMonitor::isEnabled())
+    {
+        g.drawText("Timing compiled out (EQ_PERFORMANCE_MONITOR=0)", area, juce::Justification::topLeft);
+        return;
+    }
+
+    const auto& s = monitor.getStatistics();
+    auto line = [&](const juce::String& text)
+    {
+        g.drawText(text, area.removeFromTop(16), juce::Justification::centredLeft);
+    };
+
+    line("Callback  min " + juce::String(s.minMs, 3) + "  mean " + juce::String(s.meanMs, 3)
+         + "  p99 " + juce::String(s.p99Ms, 3) + "  max " + juce::String(s.maxMs, 3) + " ms");
+    line("EQ  mean " + juce::String(s.eqMeanMs, 3) + "  p99 " + juce::String(s.eqP99Ms, 3)
+         + "  max " + juce::String(s.eqMaxMs, 3) + " ms");
+    line("Load  mean " + juce::String(100.0 * s.meanLoad, 1) + " %  p99 " + juce::String(100.0 * s.p99Load, 1)
+         + " %  max " + juce::String(100.0 * s.maxLoad, 1) + " %");
+    line(juce::String(s.numCallbacks) + " callbacks, " + juce::String(s.numOverruns) + " over deadline"
+         + (s.numDropped > 0 ? ", " + juce::String(s.numDropped) + " not counted" : juce::String()));
+
+    // Load histogram, 0 .. 200 % of the block period on a log count scale
+    auto histogram = area.reduced(0, 4).toFloat();
+    juce::uint32 largest = 1;
+    for (auto count : s.loadHistogram)
+        largest = juce::jmax(largest, count);
+
+    const float binWidth = histogram.getWidth() / static_cast<float>(PerformanceMonitor::numHistogramBins);
+    const float scale = 1.0f / std::log1p(static_cast<float>(largest));
+
+    for (int bin = 0; bin < PerformanceMonitor::numHistogramBins; ++bin)
+    {
+        const auto count = s.loadHistogram[(size_t)bin];
+        if (count == 0)
+            continue;
+
+        const float height = histogram.getHeight() * std::log1p(static_cast<float>(count)) * scale;
+        g.setColour(bin < 100 ? juce::Colours::limegreen : juce::Colours::red);
+        g.fillRect(histogram.getX() + bin * binWidth, histogram.getBottom() - height, juce::jmax(1.0f, binWidth), height);
+    }
+
+    // The deadline
+    const float deadlineX = histogram.getX() + 100.0f * binWidth;
+    g.setColour(juce::Colours::white.withAlpha(0.6f));
+    g.drawVerticalLine(juce::roundToInt(deadlineX), histogram.getY(), histogram.getBottom());
+}
+
+void PerformanceOverlay::mouseUp(const juce::MouseEvent&)
+{
+    monitor.reset();
+    repaint();
+}
+
+void PerformanceOverlay::saveReport()
+{
+    chooser = std::make_unique<juce::FileChooser>("Save timing report",
+        juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("eq-timing.txt"), "*.txt");
+
+    chooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles,
+        [this](const juce::FileChooser& fc)
+        {
+            const auto file = fc.getResult();
+            if (file == juce::File())
+                return;
+
+            if (auto result = monitor.writeReport(file); result.failed())
+                juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Timing report", result.getErrorMessage());
+        });
+}
@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    PerformanceOverlay.h
+    Created: 17 Oct 2026 9:05:33pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PerformanceMonitor.h"
+
+// Callback timing drawn over the EQ graph: the figures from PerformanceMonitor
+// and its load histogram with the deadline marked. Click to start counting
+// afresh, Save writes the report to a file.
+class PerformanceOverlay : public juce::Component,
+    private juce::Timer
+{
+    public:
+        explicit PerformanceOverlay(PerformanceMonitor& performanceMonitor);
+
+        void paint(juce::Graphics& g) override;
+        void resized() override;
+
+    private:
+        // Drains the monitor even while hidden, so its FIFO never overflows
+        void timerCallback() override;
+        void mouseUp(const juce::MouseEvent& event) override;
+        void saveReport();
+
+        PerformanceMonitor& monitor;
+        juce::TextButton saveButton{ "Save" };
+        std::unique_ptr<juce::FileChooser> chooser;
+};
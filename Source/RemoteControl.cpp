@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    RemoteControl.cpp
+    Created: 17 Oct 2026 7:40:12pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "RemoteControl.h"
+
+namespace
+{
+    // 7-bit controller value to the parameter's range: frequency and Q on a log scale, gain centred on 0 dB
+    float fromControllerValue(ControlQueue::Parameter parameter, int value)
+    {
+        const float position = static_cast<float>(value) / 127.0f;
+
+        switch (parameter)
+        {
+            case ControlQueue::Frequency:
+                return static_cast<float>(Constants::minFreq * std::pow(Constants::maxFreq / Constants::minFreq, (double)position));
+            case ControlQueue::Gain:
+                return value <= 64 ? juce::jmap(static_cast<float>(value), 0.0f, 64.0f, Constants::minDb, 0.0f)
+                                   : juce::jmap(static_cast<float>(value), 64.0f, 127.0f, 0.0f, Constants::maxDb);
+            case ControlQueue::Q:
+                return Constants::minQ * std::pow(Constants::maxQ / Constants::minQ, position);
+            default:
+                return 0.0f;
+        }
+    }
+}
+
+RemoteControl::RemoteControl(EQProcessor& processor, EQParameters& params)
+    : eq(processor), parameters(params)
+{
+    eq.setControlQueue(&audioQueue);
+}
+
+RemoteControl::~RemoteControl()
+{
+    // Stop the producers before the queues go
+    for (auto& input : midiInputs)
+        input->stop();
+    midiInputs.clear();
+
+    oscReceiver.removeListener(this);
+    oscReceiver.disconnect();
+
+    stopTimer();
+    eq.setControlQueue(nullptr);
+}
+
+int RemoteControl::openMidiInputs(int channel)
+{
+    midiChannel = juce::jlimit(0, 16, channel);
+
+    for (const auto& device : juce::MidiInput::getAvailableDevices())
+    {
+        if (auto input = juce::MidiInput::openDevice(device.identifier, this))
+        {
+            input->start();
+            midiInputs.push_back(std::move(input));
+        }
+        else
+        {
+            DBG("Could not open MIDI input " << device.name);
+        }
+    }
+
+    if (!midiInputs.empty() && !isTimerRunning())
+        startTimerHz(30);
+
+    return static_cast<int>(midiInputs.size());
+}
+
+juce::Result RemoteControl::openOsc(int port)
+{
+    // Localhost only, nothing on the network can move the EQ
+    if (!oscSocket.bindToPort(port, "127.0.0.1") || !oscReceiver.connectToSocket(oscSocket))
+        return juce::Result::fail("Could not listen for OSC on port " + juce::String(port));
+
+    oscReceiver.addListener(this);
+
+    if (!isTimerRunning())
+        startTimerHz(30);
+
+    return juce::Result::ok();
+}
+
+void RemoteControl::handleIncomingMidiMessage(juce::MidiInput*, const juce::MidiMessage& message)
+{
+    if (!message.isController())
+        return;
+
+    const int channel = midiChannel.load(std::memory_order_relaxed);
+    if (channel != 0 && message.getChannel() != channel)
+        return;
+
+    const int index = message.getControllerNumber() - firstController;
+    if (index < 0 || index >= Constants::maxBands * ControlQueue::numParameters)
+        return;
+
+    const auto parameter = static_cast<ControlQueue::Parameter>(index % ControlQueue::numParameters);
+    push(index / ControlQueue::numParameters, parameter, fromControllerValue(parameter, message.getControllerValue()));
+}
+
+void RemoteControl::oscMessageReceived(const juce::OSCMessage& message)
+{
+    if (message.size() != 1 || !(message[0].isFloat32() || message[0].isInt32()))
+        return;
+
+    juce::StringArray parts;
+    parts.addTokens(message.getAddressPattern().toString(), "/", {});
+    parts.removeEmptyStrings();
+
+    if (parts.size() != 4 || parts[0] != "eq" || parts[1] != "band")
+        return;
+
+    const int bandIndex = parts[2].getIntValue() - 1;
+    const float value = message[0].isFloat32() ? message[0].getFloat32() : static_cast<float>(message[0].getInt32());
+
+    if (parts[3] == "freq")
+        push(bandIndex, ControlQueue::Frequency, value);
+    else if (parts[3] == "gain")
+        push(bandIndex, ControlQueue::Gain, value);
+    else if (parts[3] == "q")
+        push(bandIndex, ControlQueue::Q, value);
+}
+
+void RemoteControl::timerCallback()
+{
+    if (!editorQueue.hasPending())
+        return;
+
+    auto curve = parameters.getCurve();
+    editorQueue.drain([&curve](int bandIndex, ControlQueue::Parameter parameter, float value)
+    {
+        EQProcessor::setBandParameter(curve.bands[bandIndex], parameter, value);
+    });
+
+    parameters.takeOverCurve(curve);
+}
+
+void RemoteControl::push(int bandIndex, ControlQueue::Parameter parameter, float value) noexcept
+{
+    if (!std::isfinite(value))
+        return;
+
+    switch (parameter)
+    {
+        case ControlQueue::Frequency: value = juce::jlimit(static_cast<float>(Constants::minFreq), static_cast<float>(Constants::maxFreq), value); break;
+        case ControlQueue::Gain:      value = juce::jlimit(Constants::minDb, Constants::maxDb, value); break;
+        case ControlQueue::Q:         value = juce::jlimit(Constants::minQ, Constants::maxQ, value); break;
+        default: return;
+    }
+
+    audioQueue.push(bandIndex, parameter, value);
+    editorQueue.push(bandIndex, parameter, value);
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    RemoteControl.h
+    Created: 17 Oct 2026 7:40:12pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ControlQueue.h"
+#include "EQParameters.h"
+#include "EQProcessor.h"
+
+// Band frequency, gain and Q from control surfaces:
+//
+//  MIDI CC  20 + 3 * band + { 0: frequency, 1: gain, 2: Q }, bands counted from 0 (CC 20 .. 115),
+//           from every MIDI input; 0 .. 127 spans the whole range, 64 is 0 dB gain
+//  OSC      /eq/band/<n>/freq <Hz>, /eq/band/<n>/gain <dB>, /eq/band/<n>/q <Q>, bands counted from 1,
+//           UDP on 127.0.0.1 only
+//
+// Messages go straight from the MIDI and network threads into two ControlQueues, so a
+// fader burst collapses to the latest value per band: the audio thread drains one every
+// block, the message thread the other at 30 Hz to keep EQParameters (and the UI) in step.
+class RemoteControl : private juce::MidiInputCallback,
+    private juce::OSCReceiver::Listener<juce::OSCReceiver::RealtimeCallback>,
+    private juce::Timer
+{
+    public:
+        static constexpr int firstController = 20;
+        static constexpr int defaultOscPort = 9000;
+
+        // Attaches to the processor: construct before it is prepared, destroy after audio has stopped
+        RemoteControl(EQProcessor& processor, EQParameters& parameters);
+        ~RemoteControl() override;
+
+        // Opens every MIDI input present now, listening on one channel (1 .. 16) or all of them (0).
+        // Returns the number of inputs opened.
+        int openMidiInputs(int channel = 0);
+
+        juce::Result openOsc(int port = defaultOscPort);
+
+    private:
+        // MIDI thread
+        void handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message) override;
+
+        // Network thread
+        void oscMessageReceived(const juce::OSCMessage& message) override;
+
+        // Message thread: hands the edits the audio thread already plays to EQParameters
+        void timerCallback() override;
+
+        // Any thread
+        void push(int bandIndex, ControlQueue::Parameter parameter, float value) noexcept;
+
+        EQProcessor& eq;
+        EQParameters& parameters;
+
+        ControlQueue audioQueue, editorQueue;
+
+        std::vector<std::unique_ptr<juce::MidiInput>> midiInputs;
+        std::atomic<int> midiChannel{ 0 };
+
+        // Declared before the receiver, which only borrows it
+        juce::DatagramSocket oscSocket;
+        juce::OSCReceiver oscReceiver;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RemoteControl)
+};
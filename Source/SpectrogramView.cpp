@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    SpectrogramView.cpp
+    Created: 17 Oct 2026 4:03:18pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "SpectrogramView.h"
+
+SpectrogramView::SpectrogramView()
+{
+    setOpaque(true);
+    setInterceptsMouseClicks(false, false);
+
+    juce::ColourGradient gradient(juce::Colours::black, 0.0f, 0.0f, juce::Colours::white, 1.0f, 0.0f, false);
+    gradient.addColour(0.3, juce::Colour::fromRGB(0, 0, 160));
+    gradient.addColour(0.6, juce::Colour::fromRGB(0, 200, 255));
+    gradient.addColour(0.8, juce::Colours::yellow);
+
+    for (int i = 0; i < (int)palette.size(); ++i)
+        palette[(size_t)i] = gradient.getColourAtPosition((double)i / (palette.size() - 1)).getPixelARGB();
+}
+
+void SpectrogramView::addRow(const std::vector<float>& levelDb)
+{
+    const int width = static_cast<int>(levelDb.size());
+    if (width == 0)
+        return;
+
+    // A new graph width restarts the history
+    if (history.isNull() || history.getWidth() != width)
+    {
+        history = juce::Image(juce::Image::ARGB, width, historyRows, true, juce::SoftwareImageType());
+        history.clear(history.getBounds(), juce::Colours::black);
+        newestRow = 0;
+        silentRows = historyRows;
+    }
+
+    // Once every row on screen is silent there is nothing left to scroll
+    const bool silent = std::all_of(levelDb.begin(), levelDb.end(),
+        [](float dB) { return dB <= Constants::analyzerMinDb; });
+
+    silentRows = silent ? silentRows + 1 : 0;
+    if (silentRows > historyRows)
+        return;
+
+    newestRow = (newestRow + historyRows - 1) % historyRows;
+
+    {
+        juce::Image::BitmapData bitmap(history, 0, newestRow, width, 1, juce::Image::BitmapData::writeOnly);
+        auto* pixels = reinterpret_cast<juce::PixelARGB*>(bitmap.getLinePointer(0));
+        const float maxIndex = static_cast<float>(palette.size() - 1);
+
+        for (int x = 0; x < width; ++x)
+        {
+            const float norm = juce::jmap(juce::jlimit(Constants::analyzerMinDb, Constants::analyzerMaxDb, levelDb[(size_t)x]),
+                Constants::analyzerMinDb, Constants::analyzerMaxDb, 0.0f, 1.0f);
+            pixels[x] = palette[(size_t)juce::roundToInt(norm * maxIndex)];
+        }
+    }
+
+    repaint();
+}
+
+void SpectrogramView::paint(juce::Graphics& g)
+{
+    if (history.isNull())
+    {
+        g.fillAll(juce::Colours::black);
+        return;
+    }
+
+    // Newest..bottom of the image goes on top, the wrapped-around older rows below it
+    const int width = getWidth();
+    const int height = getHeight();
+    const int newerRows = historyRows - newestRow;
+    const int split = juce::roundToInt((float)height * newerRows / historyRows);
+
+    g.drawImage(history, 0, 0, width, split, 0, newestRow, history.getWidth(), newerRows);
+
+    if (newestRow > 0)
+        g.drawImage(history, 0, split, width, height - split, 0, 0, history.getWidth(), newestRow);
+}
@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    SpectrogramView.h
+    Created: 17 Oct 2026 4:03:18pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Constants.h"
+
+// Waterfall under the EQ graph: frequency across (same log grid and width as
+// the graph), time running down, newest at the top. Rows go into a ring-buffer
+// image and paint() composites its two halves by offset, so each frame only
+// rasterises the one new row.
+class SpectrogramView : public juce::Component
+{
+    public:
+        // 10 s of history at one row per UI frame (60 fps)
+        static constexpr int historyRows = 600;
+
+        SpectrogramView();
+
+        // Message thread, once per UI frame. levelDb holds one value per column.
+        void addRow(const std::vector<float>& levelDb);
+
+        void paint(juce::Graphics& g) override;
+
+    private:
+        juce::Image history;
+        int newestRow = 0; // rows below it are older, wrapping around to the top
+        int silentRows = 0;
+
+        std::array<juce::PixelARGB, 256> palette;
+};
@@ -0,0 +1,225 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+    Created: 17 Oct 2026 2:12:40pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+
+namespace
+{
+    // Ballistics, in dB per second
+    constexpr float releaseDbPerSecond = 60.0f;
+    constexpr float peakReleaseDbPerSecond = 20.0f;
+    constexpr double peakHoldSeconds = 1.0;
+
+    // Below the bottom of the display, so silence draws nothing
+    constexpr float floorDb = Constants::analyzerMinDb - 10.0f;
+}
+
+SpectrumAnalyzer::SpectrumAnalyzer()
+    : juce::Thread("Spectrum analyzer"),
+      fftData(2 * fftSize)
+{
+    for (auto& tap : taps)
+    {
+        tap.fifoBuffer.resize((size_t)tap.fifo.getTotalSize());
+        tap.history.resize(fftSize);
+    }
+
+    startThread(juce::Thread::Priority::low);
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    stopThread(1000);
+}
+
+void SpectrumAnalyzer::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+}
+
+void SpectrumAnalyzer::setNumPoints(int newNumPoints)
+{
+    numPoints = juce::jmax(0, newNumPoints);
+}
+
+void SpectrumAnalyzer::pushBlock(Tap tapIndex, const juce::dsp::AudioBlock<float>& block) noexcept
+{
+    auto& tap = taps[tapIndex];
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int numChannels = static_cast<int>(block.getNumChannels());
+
+    if (numChannels == 0 || numSamples == 0 || tap.fifo.getFreeSpace() < numSamples)
+        return;
+
+    // Average of all channels, written straight into the FIFO's (up to two) free regions
+    const float gain = 1.0f / static_cast<float>(numChannels);
+    const auto scope = tap.fifo.write(numSamples);
+
+    auto mixInto = [&](int start, int size, int offset)
+    {
+        if (size <= 0)
+            return;
+
+        auto* dest = tap.fifoBuffer.data() + start;
+        juce::FloatVectorOperations::copyWithMultiply(dest, block.getChannelPointer(0) + offset, gain, size);
+
+        for (int ch = 1; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::addWithMultiply(dest, block.getChannelPointer((size_t)ch) + offset, gain, size);
+    };
+
+    mixInto(scope.startIndex1, scope.blockSize1, 0);
+    mixInto(scope.startIndex2, scope.blockSize2, scope.blockSize1);
+}
+
+void SpectrumAnalyzer::run()
+{
+    while (!threadShouldExit())
+    {
+        const double rate = sampleRate.load();
+        const int points = numPoints.load();
+
+        if (rate != binnedSampleRate || points != binnedNumPoints)
+            rebuildBinning(rate, points);
+
+        if (binnedSampleRate > 0.0 && binnedNumPoints > 1)
+        {
+            for (auto& tap : taps)
+                drainTap(tap);
+        }
+
+        // A hop is about 21 ms at 48 kHz
+        wait(10);
+    }
+}
+
+void SpectrumAnalyzer::rebuildBinning(double rate, int points)
+{
+    binnedSampleRate = rate;
+    binnedNumPoints = points;
+
+    if (rate <= 0.0 || points < 2)
+        return;
+
+    const double frameSeconds = hopSize / rate;
+    releasePerFrame = static_cast<float>(releaseDbPerSecond * frameSeconds);
+    peakReleasePerFrame = static_cast<float>(peakReleaseDbPerSecond * frameSeconds);
+    peakHoldFrames = static_cast<int>(peakHoldSeconds / frameSeconds);
+
+    // Each point covers half a step either side in log frequency
+    const double binsPerHz = fftSize / rate;
+    const int nyquistBin = fftSize / 2;
+    auto binAt = [&](double pointPosition)
+    {
+        return Constants::minFreq * std::pow(Constants::maxFreq / Constants::minFreq, pointPosition / (points - 1)) * binsPerHz;
+    };
+
+    pointBins.resize((size_t)points);
+    for (int i = 0; i < points; ++i)
+    {
+        const double centre = binAt(i);
+        auto& bins = pointBins[(size_t)i];
+
+        if (centre >= nyquistBin)
+        {
+            bins = { -1, -1, 0.0f };
+            continue;
+        }
+
+        bins.first = static_cast<int>(std::ceil(binAt(i - 0.5)));
+        bins.last = juce::jmin(nyquistBin, static_cast<int>(std::floor(binAt(i + 0.5))));
+        bins.position = static_cast<float>(centre);
+    }
+
+    for (auto& tap : taps)
+    {
+        tap.levelDb.assign((size_t)points, floorDb);
+        tap.peakDb.assign((size_t)points, floorDb);
+        tap.holdFrames.assign((size_t)points, 0);
+    }
+}
+
+void SpectrumAnalyzer::drainTap(TapState& tap)
+{
+    while (tap.fifo.getNumReady() >= hopSize)
+    {
+        // Slide the window along by one hop
+        std::copy(tap.history.begin() + hopSize, tap.history.end(), tap.history.begin());
+        auto* dest = tap.history.data() + (fftSize - hopSize);
+
+        {
+            const auto scope = tap.fifo.read(hopSize);
+            std::copy_n(tap.fifoBuffer.data() + scope.startIndex1, scope.blockSize1, dest);
+            std::copy_n(tap.fifoBuffer.data() + scope.startIndex2, scope.blockSize2, dest + scope.blockSize1);
+        }
+
+        analyseFrame(tap);
+    }
+}
+
+void SpectrumAnalyzer::analyseFrame(TapState& tap)
+{
+    std::copy(tap.history.begin(), tap.history.end(), fftData.begin());
+    window.multiplyWithWindowingTable(fftData.data(), (size_t)fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data(), true);
+
+    // A full-scale sine reads 0 dB: the Hann window's coherent gain is 1/2 and
+    // only the positive-frequency half of the sine's energy is in the bins
+    const float magnitudeScale = 4.0f / fftSize;
+    bool changed = false;
+
+    for (int i = 0; i < binnedNumPoints; ++i)
+    {
+        const auto& bins = pointBins[(size_t)i];
+        float magnitude = 0.0f;
+
+        if (bins.first < 0)
+            magnitude = 0.0f;
+        else if (bins.first <= bins.last)
+            magnitude = *std::max_element(fftData.data() + bins.first, fftData.data() + bins.last + 1);
+        else
+        {
+            const int bin = static_cast<int>(bins.position);
+            const float frac = bins.position - static_cast<float>(bin);
+            magnitude = fftData[(size_t)bin] + frac * (fftData[(size_t)bin + 1] - fftData[(size_t)bin]);
+        }
+
+        const float dB = juce::Decibels::gainToDecibels(magnitude * magnitudeScale, floorDb);
+
+        // Instant attack, linear release
+        float& level = tap.levelDb[(size_t)i];
+        const float newLevel = juce::jmax(dB, level - releasePerFrame, floorDb);
+
+        // Peaks hold for a second, then fall slower than the level
+        float& peak = tap.peakDb[(size_t)i];
+        float newPeak = peak;
+        if (newLevel >= peak)
+        {
+            newPeak = newLevel;
+            tap.holdFrames[(size_t)i] = peakHoldFrames;
+        }
+        else if (tap.holdFrames[(size_t)i] > 0)
+            --tap.holdFrames[(size_t)i];
+        else
+            newPeak = juce::jmax(newLevel, peak - peakReleasePerFrame);
+
+        changed = changed || newLevel != level || newPeak != peak;
+        level = newLevel;
+        peak = newPeak;
+    }
+
+    // Silence settles on the floor, after which the UI has nothing to repaint
+    if (!changed)
+        return;
+
+    auto& spectrum = tap.output.getWriteBuffer();
+    spectrum.levelDb = tap.levelDb;
+    spectrum.peakDb = tap.peakDb;
+    tap.output.publish();
+}
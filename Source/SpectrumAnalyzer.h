@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+    Created: 17 Oct 2026 2:12:40pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Constants.h"
+#include "TripleBuffer.h"
+
+// Pre- and post-EQ spectra for the graph. The audio thread only copies each
+// block (mixed to mono) into a wait-free SPSC FIFO; a background thread cuts
+// overlapping Hann-windowed frames, runs the FFT, bins the result onto the
+// display's log-frequency grid and applies smoothing and peak hold. Finished
+// spectra reach the UI through a TripleBuffer per tap.
+class SpectrumAnalyzer : private juce::Thread
+{
+    public:
+        enum Tap
+        {
+            PreEQ,
+            PostEQ,
+            numTaps
+        };
+
+        static constexpr int fftOrder = 12;
+        static constexpr int fftSize = 1 << fftOrder;
+        static constexpr int hopSize = fftSize / 4; // 75% overlap
+
+        // One value per display point, evenly spaced in log frequency over minFreq..maxFreq
+        struct Spectrum
+        {
+            std::vector<float> levelDb;
+            std::vector<float> peakDb;
+        };
+
+        SpectrumAnalyzer();
+        ~SpectrumAnalyzer() override;
+
+        // Any thread
+        void prepare(double newSampleRate);
+
+        // Audio thread. Drops the block if the analyzer has fallen behind, never waits.
+        void pushBlock(Tap tap, const juce::dsp::AudioBlock<float>& block) noexcept;
+
+        // Message thread. Usually the graph width in pixels.
+        void setNumPoints(int newNumPoints);
+
+        // Message thread. Returns true if getSpectrum() holds a newer spectrum.
+        bool pullSpectrum(Tap tap) noexcept { return taps[tap].output.pull(); }
+        const Spectrum& getSpectrum(Tap tap) const noexcept { return taps[tap].output.getReadBuffer(); }
+
+    private:
+        struct TapState
+        {
+            // Audio thread to analyzer thread, mono
+            juce::AbstractFifo fifo{ 1 << 15 };
+            std::vector<float> fifoBuffer;
+
+            // Analyzer thread only
+            std::vector<float> history;
+            std::vector<float> levelDb, peakDb;
+            std::vector<int> holdFrames;
+
+            // Analyzer thread to message thread
+            TripleBuffer<Spectrum> output;
+        };
+
+        // Display point to FFT bins: the loudest bin in [first, last], or an
+        // interpolated value at position when the point falls between two bins
+        struct PointBins
+        {
+            int first;
+            int last;
+            float position;
+        };
+
+        void run() override;
+        void rebuildBinning(double rate, int points);
+        void drainTap(TapState& tap);
+        void analyseFrame(TapState& tap);
+
+        std::atomic<double> sampleRate{ 0.0 };
+        std::atomic<int> numPoints{ 0 };
+
+        std::array<TapState, numTaps> taps;
+
+        // Analyzer thread only
+        juce::dsp::FFT fft{ fftOrder };
+        juce::dsp::WindowingFunction<float> window{ static_cast<size_t>(fftSize), juce::dsp::WindowingFunction<float>::hann, false };
+        std::vector<float> fftData;
+        std::vector<PointBins> pointBins;
+        double binnedSampleRate = 0.0;
+        int binnedNumPoints = 0;
+        float releasePerFrame = 0.0f;
+        float peakReleasePerFrame = 0.0f;
+        int peakHoldFrames = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyzer)
+};
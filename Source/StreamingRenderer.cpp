@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+    StreamingRenderer.cpp
+    Created: 16 Oct 2026 3:20:47pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "StreamingRenderer.h"
+#include "EQProcessor.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    // Blocking queue of chunk indices between two pipeline stages.
+    // Only numChunks indices ever circulate, which is what bounds the pipeline.
+    class SlotQueue
+    {
+        public:
+            static constexpr int endOfStream = -1;
+
+            void push(int slot)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    slots.push_back(slot);
+                }
+                condition.notify_one();
+            }
+
+            int pop()
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this]() { return !slots.empty(); });
+
+                const int slot = slots.front();
+                slots.pop_front();
+                return slot;
+            }
+
+        private:
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::deque<int> slots;
+    };
+
+    // Memory-mapped where the format supports it, streamed otherwise
+    class ChunkReader
+    {
+        public:
+            ChunkReader(juce::AudioFormatManager& formatManager, const juce::File& file)
+            {
+                if (auto* format = formatManager.findFormatForFileExtension(file.getFileExtension()))
+                    mapped.reset(format->createMemoryMappedReader(file));
+
+                if (mapped == nullptr)
+                    streamed.reset(formatManager.createReaderFor(file));
+            }
+
+            juce::AudioFormatReader* get() const { return mapped != nullptr ? mapped.get() : streamed.get(); }
+            bool isMemoryMapped() const { return mapped != nullptr; }
+
+            bool read(juce::AudioBuffer<float>& dest, int numSamples, juce::int64 position)
+            {
+                // Only the current chunk is mapped, so the mapping never grows with the file
+                if (mapped != nullptr
+                    && !mapped->mapSectionOfFile(juce::Range<juce::int64>(position, position + numSamples)))
+                    return false;
+
+                return get()->read(&dest, 0, numSamples, position, true, true);
+            }
+
+        private:
+            std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped;
+            std::unique_ptr<juce::AudioFormatReader> streamed;
+    };
+
+    struct Chunk
+    {
+        juce::AudioBuffer<float> buffer;
+        int numSamples = 0;
+    };
+}
+
+StreamingRenderer::FileResult StreamingRenderer::render(const juce::File& input, const juce::File& output,
+                                                        const EQSettings::Bands& bands, const Options& options)
+{
+    FileResult fileResult;
+
+    if (input == output)
+    {
+        fileResult.result = juce::Result::fail("Output would overwrite the input");
+        return fileResult;
+    }
+
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    ChunkReader chunkReader(formatManager, input);
+    auto* reader = chunkReader.get();
+    if (reader == nullptr)
+    {
+        fileResult.result = juce::Result::fail("Unreadable or unsupported format");
+        return fileResult;
+    }
+
+    fileResult.memoryMapped = chunkReader.isMemoryMapped();
+
+    auto* format = formatManager.findFormatForFileExtension(output.getFileExtension());
+    const auto numChannels = static_cast<int>(reader->numChannels);
+    const auto length = reader->lengthInSamples;
+
+    output.deleteFile();
+    std::unique_ptr<juce::FileOutputStream> stream(output.createOutputStream());
+
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+    if (format != nullptr && stream != nullptr)
+        writer.reset(format->createWriterFor(stream.get(), reader->sampleRate, static_cast<unsigned int>(numChannels),
+                                             static_cast<int>(reader->bitsPerSample), reader->metadataValues, 0));
+
+    if (writer == nullptr)
+    {
+        fileResult.result = juce::Result::fail("Could not create " + output.getFullPathName());
+        return fileResult;
+    }
+
+    // The writer owns the stream now
+    stream.release();
+
+    EQProcessor eq;
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = reader->sampleRate;
+    spec.maximumBlockSize = static_cast<juce::uint32>(options.blockSize);
+    spec.numChannels = static_cast<juce::uint32>(numChannels);
+
+    eq.prepare(spec);
+
+    EQParameters parameters(eq);
+    EQSettings::apply(bands, parameters);
+
+    // All the audio memory this render will ever use
+    std::vector<Chunk> chunks((size_t)juce::jmax(2, options.numChunks));
+    for (auto& chunk : chunks)
+        chunk.buffer.setSize(numChannels, options.chunkSize);
+
+    SlotQueue freeSlots, readSlots, processedSlots;
+    for (int i = 0; i < (int)chunks.size(); ++i)
+        freeSlots.push(i);
+
+    std::atomic<bool> readFailed{ false }, writeFailed{ false };
+
+    std::thread readerThread([&]()
+    {
+        for (juce::int64 position = 0; position < length && !writeFailed; position += options.chunkSize)
+        {
+            const int slot = freeSlots.pop();
+            auto& chunk = chunks[(size_t)slot];
+            chunk.numSamples = static_cast<int>(juce::jmin<juce::int64>(options.chunkSize, length - position));
+
+            if (!chunkReader.read(chunk.buffer, chunk.numSamples, position))
+            {
+                readFailed = true;
+                freeSlots.push(slot);
+                break;
+            }
+
+            readSlots.push(slot);
+        }
+
+        readSlots.push(SlotQueue::endOfStream);
+    });
+
+    std::thread writerThread([&]()
+    {
+        for (;;)
+        {
+            const int slot = processedSlots.pop();
+            if (slot == SlotQueue::endOfStream)
+                break;
+
+            // Keep draining after a failure so the reader never waits on a free slot forever
+            auto& chunk = chunks[(size_t)slot];
+            if (!writeFailed && !writer->writeFromAudioSampleBuffer(chunk.buffer, 0, chunk.numSamples))
+                writeFailed = true;
+
+            freeSlots.push(slot);
+        }
+    });
+
+    // The EQ runs on this thread, between the two I/O stages
+    for (;;)
+    {
+        const int slot = readSlots.pop();
+        if (slot == SlotQueue::endOfStream)
+            break;
+
+        // In blocks of at most the prepared size, the oversampling and convolution buffers are sized for that
+        auto& chunk = chunks[(size_t)slot];
+        const juce::dsp::AudioBlock<float> block(chunk.buffer);
+        for (int offset = 0; offset < chunk.numSamples; offset += options.blockSize)
+        {
+            const int numSamples = juce::jmin(options.blockSize, chunk.numSamples - offset);
+            eq.process(block.getSubBlock(static_cast<size_t>(offset), static_cast<size_t>(numSamples)));
+        }
+
+        processedSlots.push(slot);
+    }
+
+    processedSlots.push(SlotQueue::endOfStream);
+
+    readerThread.join();
+    writerThread.join();
+
+    // Flushes and finalises the header
+    writer.reset();
+
+    if (readFailed)
+        fileResult.result = juce::Result::fail("Read failed");
+    else if (writeFailed)
+        fileResult.result = juce::Result::fail("Write failed");
+
+    fileResult.audioSeconds = static_cast<double>(length) / reader->sampleRate;
+    fileResult.wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    return fileResult;
+}
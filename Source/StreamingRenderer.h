@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    StreamingRenderer.h
+    Created: 16 Oct 2026 3:20:47pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "EQSettings.h"
+
+// Renders one file through an EQProcessor in fixed-size chunks, so memory use
+// does not depend on the file length. Reading, processing and writing run on
+// three threads connected by a small ring of chunk buffers:
+//
+//   reader thread -> calling thread (EQ) -> writer thread -> back to the reader
+//
+// WAV and AIFF inputs are read through a memory-mapped reader, remapped one chunk
+// at a time. Other formats fall back to the regular streaming reader.
+class StreamingRenderer
+{
+    public:
+        struct Options
+        {
+            int blockSize = 512;
+            int chunkSize = 1 << 16;   // samples per chunk
+            int numChunks = 4;         // chunks in flight
+        };
+
+        struct FileResult
+        {
+            juce::Result result = juce::Result::ok();
+            double audioSeconds = 0.0;
+            double wallSeconds = 0.0;
+            bool memoryMapped = false;
+        };
+
+        static FileResult render(const juce::File& input, const juce::File& output,
+                                 const EQSettings::Bands& bands, const Options& options);
+};
@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.cpp
+    Created: 17 Oct 2026 10:32:09pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#include "TraceRecorder.h"
+
+namespace
+{
+    // Built before main(), so no audio thread ever runs the constructor or its allocations
+    TraceRecorder& instance = TraceRecorder::getInstance();
+}
+
+TraceRecorder& TraceRecorder::getInstance()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder()
+{
+    static_assert((eventsPerThread & (eventsPerThread - 1)) == 0, "eventsPerThread must be a power of two");
+
+    if (EQ_TRACING)
+        for (auto& ring : rings)
+            ring.events.reset(new Event[eventsPerThread]);
+}
+
+TraceRecorder::RingLease::~RingLease()
+{
+    if (ring != nullptr)
+        ring->inUse.store(false, std::memory_order_release);
+}
+
+TraceRecorder::Ring* TraceRecorder::getRingForThisThread(const char* firstEventName) noexcept
+{
+    // Destroyed as the thread exits, which frees its ring for the next thread
+    static thread_local RingLease lease;
+
+    if (!lease.hasTried)
+        claimRing(lease, firstEventName);
+
+    return lease.ring;
+}
+
+void TraceRecorder::claimRing(RingLease& lease, const char* firstEventName) noexcept
+{
+    lease.hasTried = true;
+
+    for (auto& ring : rings)
+    {
+        bool expected = false;
+        if (!ring.inUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            continue;
+
+        // Named once, into a fixed buffer: JUCE threads by their name, others by what they first traced
+        char name[Ring::maxNameLength] = {};
+        if (juce::MessageManager::existsAndIsCurrentThread())
+            std::snprintf(name, sizeof(name), "Message thread");
+        else if (auto* thread = juce::Thread::getCurrentThread())
+            thread->getThreadName().copyToUTF8(name, sizeof(name));
+        else
+            std::snprintf(name, sizeof(name), "%s thread", firstEventName);
+
+        // The previous owner's entries stay in the ring until overwritten, but are no longer written out
+        const auto version = ring.ownerVersion.load(std::memory_order_relaxed);
+        ring.ownerVersion.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        ring.ownerSince.store(ring.claimed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        for (size_t i = 0; i < sizeof(name); ++i)
+            ring.threadName[i].store(name[i], std::memory_order_relaxed);
+
+        ring.ownerVersion.store(version + 2, std::memory_order_release);
+
+        lease.ring = &ring;
+        return;
+    }
+
+    numDroppedThreads.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TraceRecorder::record(const char* name, juce::int64 startTicks, juce::int64 endTicks) noexcept
+{
+    if (!EQ_TRACING)
+        return;
+
+    auto* ring = getRingForThisThread(name);
+    if (ring == nullptr)
+        return;
+
+    const auto index = ring->claimed.load(std::memory_order_relaxed);
+    ring->claimed.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto& event = ring->events[index & (eventsPerThread - 1)];
+    event.name.store(name, std::memory_order_relaxed);
+    event.start.store(startTicks, std::memory_order_relaxed);
+    event.end.store(endTicks, std::memory_order_relaxed);
+
+    ring->published.store(index + 1, std::memory_order_release);
+}
+
+juce::Result TraceRecorder::writeTrace(const juce::File& file) const
+{
+    if (!EQ_TRACING)
+        return juce::Result::fail("Tracing was compiled out (EQ_TRACING=0)");
+
+    struct Copied
+    {
+        const char* name;
+        juce::int64 start, end;
+        int threadIndex;
+    };
+
+    std::vector<Copied> events;
+    std::vector<std::pair<int, juce::String>> threadNames;
+
+    for (int t = 0; t < maxThreads; ++t)
+    {
+        const auto& ring = rings[(size_t)t];
+
+        const auto end = ring.published.load(std::memory_order_acquire);
+        if (end == 0)
+            continue;
+
+        // The owner of what was published, unless a new owner is moving in right now
+        const auto version = ring.ownerVersion.load(std::memory_order_acquire);
+        char name[Ring::maxNameLength];
+        for (size_t i = 0; i < sizeof(name); ++i)
+            name[i] = ring.threadName[i].load(std::memory_order_relaxed);
+        name[sizeof(name) - 1] = 0;
+        const auto ownerSince = ring.ownerSince.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if ((version & 1) != 0 || ring.ownerVersion.load(std::memory_order_relaxed) != version)
+            continue;
+
+        const auto begin = juce::jmax(ownerSince, end > (juce::uint64)eventsPerThread ? end - eventsPerThread : 0);
+        if (begin >= end)
+            continue;
+
+        threadNames.push_back({ t, juce::String(name) });
+        const auto firstCopied = events.size();
+
+        for (auto i = begin; i < end; ++i)
+        {
+            const auto& event = ring.events[i & (eventsPerThread - 1)];
+            events.push_back({ event.name.load(std::memory_order_relaxed), event.start.load(std::memory_order_relaxed),
+                               event.end.load(std::memory_order_relaxed), t });
+        }
+
+        // Whatever the writer claimed since may have overwritten the oldest copies
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto claimed = ring.claimed.load(std::memory_order_relaxed);
+        const auto firstValid = claimed > (juce::uint64)eventsPerThread ? claimed - eventsPerThread : 0;
+
+        if (firstValid > begin)
+        {
+            const auto numInvalid = (size_t)juce::jmin(firstValid - begin, end - begin);
+            events.erase(events.begin() + (std::ptrdiff_t)firstCopied, events.begin() + (std::ptrdiff_t)(firstCopied + numInvalid));
+        }
+    }
+
+    juce::FileOutputStream out(file);
+    if (!out.openedOk())
+        return juce::Result::fail("Could not write " + file.getFullPathName());
+
+    out.setPosition(0);
+    out.truncate();
+
+    // Timestamps in microseconds from the oldest event
+    juce::int64 origin = std::numeric_limits<juce::int64>::max();
+    for (const auto& event : events)
+        origin = juce::jmin(origin, event.start);
+
+    const double ticksPerMicrosecond = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / 1.0e6;
+    auto toMicroseconds = [ticksPerMicrosecond](juce::int64 ticks) { return juce::String(static_cast<double>(ticks) / ticksPerMicrosecond, 3); };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    for (const auto& [t, threadName] : threadNames)
+    {
+        out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t
+            << ",\"args\":{\"name\":\"" << threadName.replaceCharacters("\"\\", "''") << "\"}}";
+        first = false;
+    }
+
+    // More threads traced at once than there are rings: the ones that came too late are missing
+    if (const int numDropped = getNumDroppedThreads(); numDropped > 0)
+    {
+        out << (first ? "" : ",\n") << "{\"name\":\"dropped_threads\",\"ph\":\"M\",\"pid\":1,\"args\":{\"count\":" << numDropped
+            << ",\"maxThreads\":" << maxThreads << "}}";
+        first = false;
+    }
+
+    for (const auto& event : events)
+    {
+        out << (first ? "" : ",\n") << "{\"name\":\"" << event.name << "\",\"cat\":\"eq\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadIndex
+            << ",\"ts\":" << toMicroseconds(event.start - origin) << ",\"dur\":" << toMicroseconds(event.end - event.start) << "}";
+        first = false;
+    }
+
+    out << "\n]}\n";
+    out.flush();
+
+    return out.getStatus();
+}
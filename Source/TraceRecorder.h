@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.h
+    Created: 17 Oct 2026 10:32:09pm
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Set to 0 (e.g. in the exporter's preprocessor definitions) to compile every trace marker out
+#ifndef EQ_TRACING
+ #define EQ_TRACING 1
+#endif
+
+// Flight recorder for stalls: every EQ_TRACE_SCOPE writes its start and end
+// time into a ring owned by the calling thread, overwriting the oldest entries,
+// so a trace of the last seconds can be written at any moment. Writing is wait-free and
+// allocation free (rings are claimed from a fixed pool on a thread's first
+// marker and handed back when the thread exits); writeTrace() produces Chrome trace JSON
+// for chrome://tracing or ui.perfetto.dev.
+class TraceRecorder
+{
+    public:
+        static constexpr int maxThreads = 16;       // traced at once, further threads are counted as dropped
+        static constexpr int eventsPerThread = 8192; // a power of two, ~20 s of audio callbacks at 256 samples
+
+        static TraceRecorder& getInstance();
+
+        // Any thread. On by default; while off a marker costs one relaxed load.
+        void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+        bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+        // Any thread. name must outlive the recorder (a string literal).
+        void record(const char* name, juce::int64 startTicks, juce::int64 endTicks) noexcept;
+
+        // Any thread but the traced ones are not paused: entries overwritten while copying are left out.
+        // Threads that found every ring in use are reported in a dropped_threads metadata event.
+        juce::Result writeTrace(const juce::File& file) const;
+
+        // Any thread. Threads that traced something but found no free ring.
+        int getNumDroppedThreads() const { return numDroppedThreads.load(std::memory_order_relaxed); }
+
+        class Scope
+        {
+            public:
+                explicit Scope(const char* eventName) noexcept
+                    : name(eventName),
+                      start(getInstance().isEnabled() ? juce::Time::getHighResolutionTicks() : 0) {}
+
+                ~Scope()
+                {
+                    if (start != 0)
+                        getInstance().record(name, start, juce::Time::getHighResolutionTicks());
+                }
+
+            private:
+                const char* const name;
+                const juce::int64 start;
+
+                JUCE_DECLARE_NON_COPYABLE(Scope)
+        };
+
+    private:
+        TraceRecorder();
+
+        struct Event
+        {
+            std::atomic<const char*> name{ nullptr };
+            std::atomic<juce::int64> start{ 0 }, end{ 0 };
+        };
+
+        // Written by the owning thread only. claimed runs ahead of published while a slot is being written,
+        // so a reader can tell which of the entries it copied may have been overwritten meanwhile.
+        // A ring outlives its thread: the next owner carries on from ownerSince, under its own name.
+        struct Ring
+        {
+            std::unique_ptr<Event[]> events;
+            std::atomic<juce::uint64> claimed{ 0 }, published{ 0 };
+            std::atomic<bool> inUse{ false };
+
+            // Owner's name and first event, rewritten on a change of owner. Odd ownerVersion while that happens.
+            std::atomic<juce::uint32> ownerVersion{ 0 };
+            std::atomic<juce::uint64> ownerSince{ 0 };
+            static constexpr size_t maxNameLength = 64;
+            std::atomic<char> threadName[maxNameLength] = {};
+        };
+
+        // Held by a thread in a thread_local, hands its ring back when the thread exits
+        struct RingLease
+        {
+            ~RingLease();
+
+            Ring* ring = nullptr;
+            bool hasTried = false;
+        };
+
+        Ring* getRingForThisThread(const char* firstEventName) noexcept;
+        void claimRing(RingLease& lease, const char* firstEventName) noexcept;
+
+        std::atomic<bool> enabled{ true };
+        std::array<Ring, maxThreads> rings;
+        std::atomic<int> numDroppedThreads{ 0 };
+
+        JUCE_DECLARE_NON_COPYABLE(TraceRecorder)
+};
+
+#if EQ_TRACING
+ #define EQ_TRACE_SCOPE_NAME(line) traceScope ## line
+ #define EQ_TRACE_SCOPE_AT(name, line) TraceRecorder::Scope EQ_TRACE_SCOPE_NAME(line) (name)
+ #define EQ_TRACE_SCOPE(name) EQ_TRACE_SCOPE_AT(name, __LINE__)
+#else
+ #define EQ_TRACE_SCOPE(name)
+#endif
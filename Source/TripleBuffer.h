@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    TripleBuffer.h
+    Created: 16 Oct 2026 10:12:40am
+    Author:  thoma
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+// Wait-free single-writer / single-reader handoff of a value type.
+// The writer fills getWriteBuffer() and calls publish(); the reader calls pull()
+// once per block and, if it returns true, reads getReadBuffer(). Intermediate
+// publishes that the reader never saw are simply overwritten (latest wins).
+template <typename T>
+class TripleBuffer
+{
+    public:
+        TripleBuffer() = default;
+
+        // ============ Writer side ============ //
+
+        T& getWriteBuffer() noexcept { return slots[writeIndex]; }
+
+        void publish() noexcept
+        {
+            const auto previous = shared.exchange(writeIndex | dirtyFlag, std::memory_order_acq_rel);
+            writeIndex = previous & indexMask;
+        }
+
+        // ============ Reader side ============ //
+
+        // Costs a single relaxed load when nothing new has been published.
+        bool pull() noexcept
+        {
+            if ((shared.load(std::memory_order_relaxed) & dirtyFlag) == 0)
+                return false;
+
+            const auto previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+            readIndex = previous & indexMask;
+            return true;
+        }
+
+        const T& getReadBuffer() const noexcept { return slots[readIndex]; }
+
+    private:
+        static constexpr int indexMask = 3;
+        static constexpr int dirtyFlag = 4;
+
+        std::array<T, 3> slots{};
+
+        // Index of the slot in the middle, plus the dirty flag
+        std::atomic<int> shared{ 1 };
+
+        int writeIndex = 0;
+        int readIndex = 2;
+};
@@ -0,0 +1,514 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026 9:12:40am
+    Author:  thoma
+
+    Concurrency stress test for EQProcessor, meant to run under ThreadSanitizer
+    (the Linux exporter builds with -fsanitize=thread). One thread processes
+    audio as fast as it can while the others do what the app does to it:
+
+        message thread   setCurve (with and without morphs), getMagnitudeForFrequency,
+                         oversampling and linear-phase switches
+        remote threads   ControlQueue pushes, like MIDI and OSC
+        observer thread  latency and load getters, trace capture
+
+    A last phase plays a plugin host instead: the curve comes from automation
+    points at random offsets within each block, which JUCE's plugin wrappers
+    never produce (they give one point at offset 0). It also checks that
+    splitting a block at the points matches processing the pieces one by one.
+
+    The output is checked for NaN/inf and for peaks or sample-to-sample jumps
+    beyond what a serial run of the same kind of edits produces. Exits with 1
+    on any failure, so it can gate a CI job.
+
+        EQStress [--seconds=20] [--block-size=64] [--channels=2] [--remote-threads=3]
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <thread>
+#include "../../Source/ControlQueue.h"
+#include "../../Source/EQProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+
+    // Serial runs are short and deterministic, this is how many blocks they cover
+    constexpr int referenceBlocks = 20000;
+
+    // Output may exceed the serial reference by this factor before it counts as a glitch.
+    // The stressed run sees more edits than the reference, so it is allowed rarer extremes.
+    constexpr float tolerance = 4.0f;
+
+    struct Options
+    {
+        double seconds = 20.0;
+        int blockSize = 64;
+        int numChannels = 2;
+        int numRemoteThreads = 3;
+    };
+
+    // Edits touch the first few bands only and keep gains moderate, so the loudest curve
+    // (every band boosting the same spot) stays near 24 dB and the reference is a tight bound.
+    // Jumps of very low bands ring far louder than anything concurrency adds, so they stay out too.
+    constexpr int numEditedBands = 4;
+    constexpr double minEditFreq = 100.0, maxEditFreq = 10000.0;
+    constexpr float maxEditGainDb = 6.0f;
+    constexpr float minEditQ = 0.3f, maxEditQ = 3.0f;
+
+    // Points per block in the automation phase
+    constexpr int maxAutomationPoints = 3;
+
+    enum class Phase
+    {
+        curves,
+        curvesAndModes,
+        automation
+    };
+
+    // Random edits. Each thread owns one, seeded differently.
+    class EditSource
+    {
+        public:
+            explicit EditSource(juce::int64 seed) : random(seed) {}
+
+            EQProcessor::Curve nextCurve()
+            {
+                auto curve = EQProcessor::getDefaultCurve();
+                curve.numBands = 1 + random.nextInt(numEditedBands);
+
+                for (int i = 0; i < curve.numBands; ++i)
+                {
+                    auto& band = curve.bands[i];
+                    band.type = static_cast<EQProcessor::FilterType>(random.nextInt(3));
+                    band.freq = nextValue(ControlQueue::Frequency);
+                    band.gainDb = nextValue(ControlQueue::Gain);
+                    band.Q = nextValue(ControlQueue::Q);
+                    band.enabled = random.nextInt(8) != 0;
+                }
+
+                return curve;
+            }
+
+            float nextValue(ControlQueue::Parameter parameter)
+            {
+                const float position = random.nextFloat();
+
+                switch (parameter)
+                {
+                    case ControlQueue::Frequency: return static_cast<float>(minEditFreq * std::pow(maxEditFreq / minEditFreq, (double)position));
+                    case ControlQueue::Gain:      return juce::jmap(position, -maxEditGainDb, maxEditGainDb);
+                    case ControlQueue::Q:         return juce::jmap(position, minEditQ, maxEditQ);
+                    default:                      return 0.0f;
+                }
+            }
+
+            // Glides are short so that edits often land in the middle of one
+            double nextMorphSeconds() { return random.nextBool() ? 0.0 : 0.002 * random.nextInt(10); }
+
+            int nextInt(int maxValue) { return random.nextInt(maxValue); }
+
+        private:
+            juce::Random random;
+    };
+
+    // Two sines well inside the passband, continuous across blocks
+    class TestSignal
+    {
+        public:
+            void fill(juce::AudioBuffer<float>& buffer)
+            {
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                {
+                    const double t = static_cast<double>(position++) / sampleRate;
+                    const auto value = static_cast<float>(0.1 * std::sin(juce::MathConstants<double>::twoPi * 97.0 * t)
+                                                        + 0.05 * std::sin(juce::MathConstants<double>::twoPi * 1310.0 * t));
+
+                    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                        buffer.setSample(ch, i, value);
+                }
+            }
+
+        private:
+            juce::int64 position = 0;
+    };
+
+    // Audio thread only
+    class OutputChecker
+    {
+        public:
+            explicit OutputChecker(int numChannels) : previous((size_t)numChannels, 0.0f) {}
+
+            void check(const juce::AudioBuffer<float>& buffer)
+            {
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                {
+                    const auto* samples = buffer.getReadPointer(ch);
+                    auto& last = previous[(size_t)ch];
+
+                    for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    {
+                        if (!std::isfinite(samples[i]))
+                        {
+                            if (numNonFinite++ == 0)
+                                firstNonFiniteBlock = numBlocks;
+
+                            last = 0.0f;
+                            continue;
+                        }
+
+                        peak = juce::jmax(peak, std::abs(samples[i]));
+                        maxStep = juce::jmax(maxStep, std::abs(samples[i] - last));
+                        last = samples[i];
+                    }
+                }
+
+                ++numBlocks;
+            }
+
+            juce::int64 numBlocks = 0, numNonFinite = 0, firstNonFiniteBlock = -1;
+            float peak = 0.0f, maxStep = 0.0f;
+
+        private:
+            std::vector<float> previous;
+    };
+
+    void prepare(EQProcessor& eq, const Options& options, Phase phase)
+    {
+        eq.setCurveFromAutomation(phase == Phase::automation);
+        eq.prepare({ sampleRate, static_cast<juce::uint32>(options.blockSize), static_cast<juce::uint32>(options.numChannels) });
+    }
+
+    // Every so often: another oversampling factor, or linear phase on or off
+    void switchMode(EQProcessor& eq, EditSource& edits)
+    {
+        if (edits.nextInt(4) == 0)
+            eq.setLinearPhase(!eq.isLinearPhase());
+        else
+            eq.setOversamplingOrder(edits.nextInt(EQProcessor::maxOversamplingOrder + 1));
+    }
+
+    // Up to maxAutomationPoints new curves at sorted random offsets, as a host splitting at automation would send them.
+    // About one block in four is automated, the rate of the other phases' curves.
+    struct AutomationPoints
+    {
+        int fill(EditSource& edits, int blockSize)
+        {
+            numPoints = edits.nextInt(4) == 0 ? 1 + edits.nextInt(maxAutomationPoints) : 0;
+
+            std::array<int, maxAutomationPoints> offsets{};
+            for (int i = 0; i < numPoints; ++i)
+                offsets[(size_t)i] = edits.nextInt(blockSize);
+            std::sort(offsets.begin(), offsets.begin() + numPoints);
+
+            for (int i = 0; i < numPoints; ++i)
+            {
+                curves[(size_t)i] = edits.nextCurve();
+                points[(size_t)i] = { offsets[(size_t)i], &curves[(size_t)i] };
+            }
+
+            return numPoints;
+        }
+
+        std::array<EQProcessor::Curve, maxAutomationPoints> curves;
+        std::array<EQProcessor::AutomationPoint, maxAutomationPoints> points;
+        int numPoints = 0;
+    };
+
+    // Same kinds of edits, interleaved with the blocks on one thread: the output a correct processor may produce
+    OutputChecker runReference(const Options& options, Phase phase)
+    {
+        EQProcessor eq;
+        prepare(eq, options, phase);
+
+        ControlQueue queue;
+        if (phase != Phase::automation)
+            eq.setControlQueue(&queue);
+
+        EditSource edits(1);
+        TestSignal signal;
+        OutputChecker checker(options.numChannels);
+        juce::AudioBuffer<float> buffer(options.numChannels, options.blockSize);
+
+        AutomationPoints automation;
+
+        // About the rates the stressed run sees: a curve every few blocks, a remote edit in between
+        for (int block = 0; block < referenceBlocks; ++block)
+        {
+            if (phase == Phase::automation)
+            {
+                automation.fill(edits, options.blockSize);
+                signal.fill(buffer);
+                eq.process(juce::dsp::AudioBlock<float>(buffer), automation.points.data(), automation.numPoints);
+                checker.check(buffer);
+                continue;
+            }
+
+            if (block % 4 == 0)
+                eq.setCurve(edits.nextCurve(), edits.nextMorphSeconds());
+
+            if (block % 4 == 2)
+            {
+                const auto parameter = static_cast<ControlQueue::Parameter>(edits.nextInt(ControlQueue::numParameters));
+                queue.push(edits.nextInt(numEditedBands), parameter, edits.nextValue(parameter));
+            }
+
+            if (phase == Phase::curvesAndModes && block % 200 == 0)
+                switchMode(eq, edits);
+
+            signal.fill(buffer);
+            eq.process(buffer);
+            checker.check(buffer);
+        }
+
+        eq.setControlQueue(nullptr);
+        return checker;
+    }
+
+    // Samples where a block split at its automation points differs from the same pieces processed one by one,
+    // each with its curve at offset 0 (what a host splitting its cycles would do). Both must come out identical.
+    juce::int64 countSplitMismatches(const Options& options)
+    {
+        EQProcessor whole, pieces;
+        prepare(whole, options, Phase::automation);
+        prepare(pieces, options, Phase::automation);
+
+        EditSource edits(3);
+        TestSignal signal;
+        AutomationPoints automation;
+        juce::AudioBuffer<float> buffer(options.numChannels, options.blockSize), copy(options.numChannels, options.blockSize);
+        juce::int64 numMismatches = 0;
+
+        for (int block = 0; block < referenceBlocks; ++block)
+        {
+            const int numPoints = automation.fill(edits, options.blockSize);
+            signal.fill(buffer);
+            copy.makeCopyOf(buffer);
+
+            whole.process(juce::dsp::AudioBlock<float>(buffer), automation.points.data(), numPoints);
+
+            const juce::dsp::AudioBlock<float> copyBlock(copy);
+            for (int piece = 0; piece <= numPoints; ++piece)
+            {
+                const int start = piece == 0 ? 0 : automation.points[(size_t)(piece - 1)].sampleOffset;
+                const int end = piece < numPoints ? automation.points[(size_t)piece].sampleOffset : options.blockSize;
+                const EQProcessor::AutomationPoint point{ 0, piece == 0 ? nullptr : automation.curves.data() + piece - 1 };
+
+                pieces.process(copyBlock.getSubBlock((size_t)start, (size_t)(end - start)), &point, piece == 0 ? 0 : 1);
+            }
+
+            for (int ch = 0; ch < options.numChannels; ++ch)
+                for (int i = 0; i < options.blockSize; ++i)
+                    if (buffer.getSample(ch, i) != copy.getSample(ch, i))
+                        ++numMismatches;
+        }
+
+        return numMismatches;
+    }
+
+    struct StressResult
+    {
+        OutputChecker output;
+        juce::int64 numCurves = 0, numRemoteEdits = 0, numBadMagnitudes = 0;
+    };
+
+    StressResult runStress(const Options& options, double seconds, Phase phase)
+    {
+        EQProcessor eq;
+        prepare(eq, options, phase);
+
+        // A host owns the curve outright, remote control does not apply
+        ControlQueue queue;
+        const bool remoteControl = phase != Phase::automation;
+        if (remoteControl)
+            eq.setControlQueue(&queue);
+
+        StressResult result{ OutputChecker(options.numChannels) };
+        std::atomic<bool> stop{ false };
+        std::atomic<juce::int64> numCurves{ 0 }, numRemoteEdits{ 0 };
+
+        std::thread audioThread([&]()
+        {
+            EditSource edits(3);
+            TestSignal signal;
+            AutomationPoints automation;
+            juce::AudioBuffer<float> buffer(options.numChannels, options.blockSize);
+
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                signal.fill(buffer);
+
+                if (phase == Phase::automation)
+                {
+                    automation.fill(edits, options.blockSize);
+                    eq.process(juce::dsp::AudioBlock<float>(buffer), automation.points.data(), automation.numPoints);
+                }
+                else
+                {
+                    eq.process(buffer);
+                }
+
+                result.output.check(buffer);
+            }
+        });
+
+        // Plays the message thread: the only caller of the edit-state functions, as in the app
+        std::thread messageThread([&]()
+        {
+            EditSource edits(2);
+
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                eq.setCurve(edits.nextCurve(), edits.nextMorphSeconds());
+                const auto curveCount = numCurves.fetch_add(1, std::memory_order_relaxed) + 1;
+
+                for (int point = 0; point < 64; ++point)
+                {
+                    const double freq = Constants::minFreq * std::pow(Constants::maxFreq / Constants::minFreq, point / 63.0);
+                    const float magnitude = eq.getMagnitudeForFrequency(freq, eq.getDesignSampleRate());
+                    if (!std::isfinite(magnitude) || magnitude < 0.0f)
+                        ++result.numBadMagnitudes;
+                }
+
+                if (phase == Phase::curvesAndModes && curveCount % 50 == 0)
+                    switchMode(eq, edits);
+            }
+        });
+
+        std::vector<std::thread> remoteThreads;
+        for (int t = 0; t < (remoteControl ? options.numRemoteThreads : 0); ++t)
+        {
+            remoteThreads.emplace_back([&, t]()
+            {
+                EditSource edits(100 + t);
+
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    const auto parameter = static_cast<ControlQueue::Parameter>(edits.nextInt(ControlQueue::numParameters));
+                    queue.push(edits.nextInt(numEditedBands), parameter, edits.nextValue(parameter));
+                    numRemoteEdits.fetch_add(1, std::memory_order_relaxed);
+
+                    if (edits.nextInt(16) == 0)
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        // The getters documented as any-thread, plus a trace capture while everything is running
+        std::thread observerThread([&]()
+        {
+            const auto traceFile = juce::File::createTempFile(".json");
+            bool traced = false;
+            volatile double sink = 0.0;
+
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                sink = eq.getLatencyInSamples() + eq.getSampleRate() + eq.getLinearPhaseLoad();
+                for (int order = 0; order <= EQProcessor::maxOversamplingOrder; ++order)
+                    sink = sink + eq.getProcessingLoad(order);
+
+                if (!traced && numCurves.load(std::memory_order_relaxed) > 100)
+                {
+                    TraceRecorder::getInstance().writeTrace(traceFile);
+                    traced = true;
+                }
+
+                std::this_thread::yield();
+            }
+
+            traceFile.deleteFile();
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<juce::int64>(seconds * 1000.0)));
+        stop.store(true);
+
+        audioThread.join();
+        messageThread.join();
+        observerThread.join();
+        for (auto& thread : remoteThreads)
+            thread.join();
+
+        eq.setControlQueue(nullptr);
+        result.numCurves = numCurves.load();
+        result.numRemoteEdits = numRemoteEdits.load();
+        return result;
+    }
+
+    // Prints one phase and returns true if it passed
+    bool reportPhase(const juce::String& name, const OutputChecker& reference, const StressResult& stress)
+    {
+        const auto& output = stress.output;
+
+        std::cout << name << ": " << output.numBlocks << " blocks, " << stress.numCurves << " curves, "
+                  << stress.numRemoteEdits << " remote edits" << std::endl;
+        std::cout << "  peak " << output.peak << " (reference " << reference.peak << "), largest step "
+                  << output.maxStep << " (reference " << reference.maxStep << ")" << std::endl;
+
+        bool passed = true;
+        auto fail = [&passed](const juce::String& message)
+        {
+            std::cout << "  FAILED: " << message << std::endl;
+            passed = false;
+        };
+
+        if (reference.numNonFinite > 0)
+            fail("the serial reference itself produced " + juce::String(reference.numNonFinite) + " non-finite samples");
+
+        if (output.numNonFinite > 0)
+            fail(juce::String(output.numNonFinite) + " non-finite samples, the first in block " + juce::String(output.firstNonFiniteBlock));
+
+        if (output.peak > tolerance * reference.peak)
+            fail("peak beyond the reference");
+
+        if (output.maxStep > tolerance * reference.maxStep)
+            fail("discontinuity beyond the reference");
+
+        if (stress.numBadMagnitudes > 0)
+            fail(juce::String(stress.numBadMagnitudes) + " bad getMagnitudeForFrequency results");
+
+        if (output.numBlocks == 0 || stress.numCurves == 0)
+            fail("a thread made no progress");
+
+        return passed;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    Options options;
+    if (args.containsOption("--seconds"))
+        options.seconds = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+    if (args.containsOption("--block-size"))
+        options.blockSize = juce::jlimit(1, 8192, args.getValueForOption("--block-size").getIntValue());
+    if (args.containsOption("--channels"))
+        options.numChannels = juce::jlimit(1, 64, args.getValueForOption("--channels").getIntValue());
+    if (args.containsOption("--remote-threads"))
+        options.numRemoteThreads = juce::jlimit(0, 64, args.getValueForOption("--remote-threads").getIntValue());
+
+    // Curve edits alone keep the filters' state, so jumps are held to the tight reference.
+    // Mode switches restart the filters from silence and are checked in a phase of their own.
+    bool passed = true;
+
+    for (auto phase : { Phase::curves, Phase::curvesAndModes, Phase::automation })
+    {
+        const juce::String name = phase == Phase::curves ? "curves" : phase == Phase::curvesAndModes ? "curves and modes" : "automation";
+        const auto reference = runReference(options, phase);
+        const auto stress = runStress(options, options.seconds / 3.0, phase);
+        passed = reportPhase(name, reference, stress) && passed;
+    }
+
+    if (const auto numMismatches = countSplitMismatches(options); numMismatches > 0)
+    {
+        std::cout << "automation split: FAILED, " << numMismatches << " samples differ from processing the pieces one by one" << std::endl;
+        passed = false;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}